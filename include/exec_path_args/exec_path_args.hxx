@@ -19,6 +19,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <initializer_list>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -26,9 +30,12 @@
 
 #include "exec_path_args/pipe_helper.hxx"
 #include "exec_path_args/process_handle_t.hxx"
+#include "exec_path_args/spawn_options.hxx"
 
 namespace exec_path_args::os_wrapper {
 
+struct pending_spawn; // implementation detail
+
 struct exec_path_args {
   enum class state : char { uninitialzied, ready, running, finished };
 
@@ -37,14 +44,54 @@ struct exec_path_args {
     state current;
   };
 
+  enum class exit_reason : char {
+    exited,   // `get_return_code` is the exit status
+    signaled, // `get_return_code` is the signal number
+    killed,   // by `do_kill`
+    // `RLIMIT_CPU` exceeded - `SIGXCPU` at the soft limit, or `SIGKILL` at the
+    // hard one (if `spawn_options::resource_limits` contain `RLIMIT_CPU`)
+    cpu_limit_exceeded,
+    // `RLIMIT_FSIZE` exceeded - `SIGXFSZ`
+    file_size_limit_exceeded,
+    // its deadline passed (see `process_group::set_deadline`) - however it
+    // terminated afterwards
+    timed_out,
+    // as `timed_out`, but for not writing anything for too long (see
+    // `process_group::set_inactivity_timeout`)
+    inactive
+    // NOTE: e.g. `RLIMIT_AS` or `RLIMIT_NOFILE` make only syscalls fail, so
+    // it's up to the child how it terminates then
+  };
+
+  // of the child itself (not of any of its own children it didn't wait for),
+  // as reported by the kernel when it's reaped
+  // https://man7.org/linux/man-pages/man2/getrusage.2.html
+  struct resource_usage {
+    long long user_cpu_ns{0};
+    long long system_cpu_ns{0};
+    long max_rss_kib{0};
+  };
+
   friend void swap(exec_path_args &lhs, exec_path_args &rhs) noexcept;
 
+  // see `spawn_batch.hxx`
+  friend std::vector<std::exception_ptr>
+  spawn_batch(exec_path_args *const cmds, std::size_t const count,
+              int const num_threads);
+  // see `kill_all.hxx`
+  friend void kill_all(exec_path_args *const cmds, std::size_t const count);
+
   exec_path_args() = default;
 
   explicit exec_path_args(std::string &&aPath,
-                          std::vector<std::string> &&aArgs) noexcept
-      : path{std::move(aPath)}, args{std::move(aArgs)}, current_state{
-                                                            state::ready} {}
+                          std::vector<std::string> &&aArgs)
+      : exec_path_args{std::move(aPath), std::move(aArgs), spawn_options{}} {}
+
+  explicit exec_path_args(std::string &&aPath, std::vector<std::string> &&aArgs,
+                          spawn_options &&aOptions)
+      : inputs{std::make_unique<spawn_inputs>(spawn_inputs{
+            std::move(aPath), std::move(aArgs), std::move(aOptions)})},
+        current_state{state::ready} {}
 
   [[nodiscard]] bool manages_process() const {
     return handle != invalid_process_handle;
@@ -53,6 +100,8 @@ struct exec_path_args {
   exec_path_args(exec_path_args &&rhs) noexcept;
   exec_path_args &operator=(exec_path_args &&rhs) noexcept;
 
+  // a still running process is killed, but not waited for - it's reaped
+  // asynchronously (see `impl/reaper.hxx`)
   ~exec_path_args() noexcept;
 
   // timeout_until_it_finishes_ms (as in
@@ -60,6 +109,9 @@ struct exec_path_args {
   // - negative -> wait indefinitely
   // - zero -> don't block
   // - positive -> wait up to given time
+  // NOTE: when spawning (e.g. in `state::ready`), throws if anything in the
+  // child fails before or during `execv` (e.g. applying `spawn_options`); the
+  // state is left unchanged in such case
   [[nodiscard]] states
   update_and_get_state(int const timeout_until_it_finishes_ms = 0);
 
@@ -73,7 +125,21 @@ struct exec_path_args {
     return current_state == state::finished;
   }
 
+  // blocks until all of `data` is written
   void send_to_stdin(std::string_view const data);
+  // the same for `pieces` one after another (e.g. header, payload & trailer),
+  // without concatenating them first - in as few `writev`s as possible
+  void send_to_stdin(std::string_view const *const pieces,
+                     std::size_t const count);
+  void send_to_stdin(std::initializer_list<std::string_view> const pieces) {
+    send_to_stdin(pieces.begin(), pieces.size());
+  }
+  // never blocks - writes only what fits into the pipe right now & returns how
+  // many bytes (of `data`, or of all `pieces` together) that was
+  [[nodiscard]] std::size_t try_send_to_stdin(std::string_view const data);
+  [[nodiscard]] std::size_t
+  try_send_to_stdin(std::string_view const *const pieces,
+                    std::size_t const count);
   void close_stdin();
 
   // updates corresponding internal buffer and returns:
@@ -87,6 +153,21 @@ struct exec_path_args {
   [[nodiscard]] std::string get_stdout();
   [[nodiscard]] std::string get_stderr();
 
+  // the same as above, for the pipes created due to `spawn_options::extra_fds`
+  // (identified by the fd number in the child)
+  [[nodiscard]] std::string_view read_extra_output(int const child_fd,
+                                                   bool const whole = false);
+  [[nodiscard]] std::string get_extra_output(int const child_fd);
+
+  // once finished: reads whatever is left in the pipes, closes them & trims all
+  // buffers - for processes kept around (e.g. until their output is collected)
+  // to cost as little as possible; reading the buffered output keeps working,
+  // anything written later (e.g. by a grandchild) is lost
+  // NOTE: the path, arguments & options are already released once it's
+  // spawned
+  void shrink_to_fit();
+
+  // `SIGKILL`s the process & waits until it's gone
   void do_kill();
 
   // - for running process, returns `current_time - time_spawned`
@@ -98,6 +179,12 @@ struct exec_path_args {
   // NOTE: if the process was terminated by a signal, returns that signal number
   [[nodiscard]] int get_return_code() const;
 
+  // distinguishes the above
+  [[nodiscard]] exit_reason get_exit_reason() const;
+
+  // only once it's finished
+  [[nodiscard]] resource_usage get_resource_usage() const;
+
   // `pid` of the child process
   [[nodiscard]] process_handle_t get_process_handle() const { return handle; }
 
@@ -105,31 +192,80 @@ private:
   exec_path_args(exec_path_args const &rhs) noexcept = delete;
   exec_path_args &operator=(exec_path_args const &rhs) noexcept = delete;
 
-  std::string path;
-  std::vector<std::string> args;
+  // needed only until it's spawned - kept aside, so that a running (or
+  // finished) process doesn't carry them around (see `complete_spawn`)
+  struct spawn_inputs {
+    std::string path;
+    std::vector<std::string> args;
+    spawn_options options;
+  };
+  std::unique_ptr<spawn_inputs> inputs;
 
   long long time_spawned_ns{0};
   long long time_finished_ns{0};
 
   process_handle_t handle{invalid_process_handle};
+  native_fd_t pid_fd{invalid_fd};
   pipe_helper stdin_pipe;
   pipe_helper stdout_pipe;
   pipe_helper stderr_pipe;
 
-  [[noreturn]] void exec_in_child(char *args[]);
-
   state current_state{state::uninitialzied};
 
   int return_code{};
+  exit_reason reason{exit_reason::exited};
+  bool cpu_limited{false}; // see `classify_exit`
+  resource_usage usage{};
+
+  struct captured_output {
+    int child_fd;
+    pipe_helper pipe;
+    std::string buffer;
+    ssize_t consumed_bytes{0};
+  };
+  // only few processes use any of it, so it's allocated on demand (see
+  // `rare_state`) instead of being carried by each of them
+  struct rarely_used {
+    // see `spawn_options::wait_tuning`
+    wait_tuner *tuner{nullptr};
+    std::uint64_t template_id{0};
+    std::vector<captured_output> extra_outputs;
+  };
+  std::unique_ptr<rarely_used> rare;
 
   std::string stdout_buffer;
   ssize_t stdout_consumed_bytes{0};
   std::string stderr_buffer;
   ssize_t stderr_consumed_bytes{0};
 
+  // creates `rare` if needed
+  [[nodiscard]] rarely_used &rare_state();
+  [[nodiscard]] wait_tuner *tuner() const noexcept {
+    return rare ? rare->tuner : nullptr;
+  }
+
+  // spawning, split into phases (so e.g. `spawn_batch` can interleave them);
+  // `complete_spawn` throws if the child failed before/during `execv`
+  void prepare_spawn(pending_spawn &pending);
+  void launch(pending_spawn &pending, char *const argv[]);
+  void complete_spawn(pending_spawn &pending);
+  void reset_pipes() noexcept;
+
+  // throws unless stdin can be written to
+  void check_stdin() const;
+
   void query_status(bool const wait_for_finishing);
+  // probes (without blocking) until it finishes or `until_ns` (of `now_ns`)
+  // passes; returns whether it finished
+  bool spin_until_finished(long long const until_ns);
+
+  // `do_kill`, split (so `kill_all` can signal everything first); `send_kill`
+  // returns whether there is anything to reap
+  [[nodiscard]] bool send_kill();
+  void reap_killed();
 
   void update_buffer(bool const for_stdout);
+  [[nodiscard]] captured_output &update_extra_buffer(int const child_fd);
 };
 
 } // namespace exec_path_args::os_wrapper
@@ -0,0 +1,72 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+
+// header-only helpers for waiting on a 32-bit word in memory shared between
+// processes (so not `FUTEX_PRIVATE_FLAG`); see `shm_ring` & `rendezvous`
+// https://man7.org/linux/man-pages/man2/futex.2.html
+namespace exec_path_args::os_wrapper::futex {
+
+[[nodiscard]] inline long long monotonic_ns() noexcept {
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return static_cast<long long>(t.tv_sec) * 1'000'000'000 + t.tv_nsec;
+}
+
+// `deadline_ns` of `monotonic_ns`, `-1` ~ none; sleeps until woken, the
+// deadline, a signal, or not at all if `word != expected` (so the caller has to
+// re-check whatever it waits for in any case); returns `false` once the
+// deadline passed
+// (`FUTEX_WAIT_BITSET` takes an absolute `CLOCK_MONOTONIC` deadline - no need
+// to recompute what's left after each wakeup)
+inline bool wait(std::atomic<std::uint32_t> &word, std::uint32_t const expected,
+                 long long const deadline_ns) noexcept {
+  timespec deadline{};
+  timespec *timeout{nullptr};
+  if (deadline_ns >= 0) {
+    deadline = {static_cast<time_t>(deadline_ns / 1'000'000'000),
+                static_cast<long>(deadline_ns % 1'000'000'000)};
+    timeout = &deadline;
+  }
+  return (syscall(static_cast<long>(SYS_futex), &word, FUTEX_WAIT_BITSET,
+                  expected, timeout, nullptr, FUTEX_BITSET_MATCH_ANY) != -1) ||
+         (errno != ETIMEDOUT);
+}
+
+inline void wake(std::atomic<std::uint32_t> &word, int const count) noexcept {
+  syscall(static_cast<long>(SYS_futex), &word, FUTEX_WAKE, count, nullptr,
+          nullptr, 0);
+}
+
+// `timeout_ms` as for `poll` (`-1` ~ forever) -> `deadline_ns` for `wait`
+[[nodiscard]] inline long long deadline_after(int const timeout_ms) noexcept {
+  return timeout_ms < 0 ? -1 : monotonic_ns() + timeout_ms * 1'000'000LL;
+}
+
+} // namespace exec_path_args::os_wrapper::futex
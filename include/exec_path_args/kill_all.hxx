@@ -0,0 +1,40 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "exec_path_args/exec_path_args.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+// the same as calling `do_kill()` on each of `cmds`, but all of them are
+// signaled first & only then reaped - so they terminate concurrently, instead
+// of one after another
+// throws `std::runtime_error` on failure (the rest is then left to their
+// destructors)
+void kill_all(exec_path_args *const cmds, std::size_t const count);
+
+inline void kill_all(std::vector<exec_path_args> &cmds) {
+  kill_all(cmds.data(), cmds.size());
+}
+
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,79 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace exec_path_args::os_wrapper {
+
+// fixed-size (~10 KiB, no allocations) histogram of durations in nanoseconds,
+// log-linearly bucketed as HdrHistogram (https://hdrhistogram.github.io/) does:
+// each power of 2 is split into `sub_buckets` equal buckets, so any recorded
+// value is known within ~3 % (values below `sub_buckets` exactly); values
+// above `max_value` (~4.9 hours) are clamped
+// NOT thread-safe
+struct latency_histogram {
+  static int constexpr sub_bucket_bits{5};
+  static long long constexpr sub_buckets{1LL << sub_bucket_bits};
+  static int constexpr max_value_bits{44};
+  static long long constexpr max_value{(1LL << max_value_bits) - 1};
+  static std::size_t constexpr num_buckets{
+      static_cast<std::size_t>(sub_buckets) *
+      (max_value_bits - sub_bucket_bits + 1)};
+
+  // negative values are recorded as `0`
+  void record(long long const value_ns) noexcept;
+
+  // adds everything recorded in `other`
+  void merge(latency_histogram const &other) noexcept;
+  void reset() noexcept;
+
+  [[nodiscard]] std::uint64_t count() const noexcept { return total_count; }
+  // (all `0` when empty)
+  [[nodiscard]] long long min() const noexcept { return min_ns; }
+  [[nodiscard]] long long max() const noexcept { return max_ns; }
+  [[nodiscard]] double mean() const noexcept;
+  // `q` in [0, 1] (e.g. `0.99` ~ p99); the highest value the bucket holding
+  // the `q`-th recorded value may contain (but within `min` & `max`)
+  [[nodiscard]] long long quantile(double const q) const noexcept;
+
+  // for export - only the non-empty buckets, ordered
+  struct bucket {
+    long long lowest_ns;
+    long long highest_ns;
+    std::uint64_t count;
+  };
+  [[nodiscard]] std::vector<bucket> buckets() const;
+
+private:
+  [[nodiscard]] static std::size_t bucket_of(long long const value) noexcept;
+  [[nodiscard]] static long long lowest_of(std::size_t const index) noexcept;
+  [[nodiscard]] static long long highest_of(std::size_t const index) noexcept;
+
+  std::uint64_t total_count{0};
+  long long min_ns{0};
+  long long max_ns{0};
+  double sum_ns{0};
+  std::uint64_t counts[num_buckets]{};
+};
+
+} // namespace exec_path_args::os_wrapper
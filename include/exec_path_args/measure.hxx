@@ -0,0 +1,86 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "exec_path_args/spawn_options.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+// runs a command repeatedly (one run at a time) & summarizes how long it took
+// & what it used - similarly to `hyperfine`, but from within C++; wall time is
+// measured from the child's successful `execv` until it's reaped (so the
+// `fork` itself isn't included), CPU times & max RSS are those the kernel
+// reports for the child (see `exec_path_args::resource_usage`)
+struct measure_options {
+  // e.g. `cpu_affinity` to pin the runs to a single (isolated) CPU; its
+  // `discard_output` is overridden by the one below
+  spawn_options spawn;
+  // see `spawn_options::discard_output` - no pipes, nothing to read meanwhile
+  bool discard_output{true};
+  // otherwise any run not exiting with `0` makes `measure` throw
+  bool ignore_failures{false};
+};
+
+struct measurement {
+  struct run {
+    long long wall_ns;
+    long long user_cpu_ns;
+    long long system_cpu_ns;
+    long max_rss_kib;
+    int return_code;
+  };
+
+  // of a single metric, over all measured runs (nearest-rank percentiles)
+  struct summary {
+    double mean;
+    double stddev; // sample standard deviation (`0` for a single run)
+    double min;
+    double median;
+    double p95;
+    double p99;
+    double max;
+  };
+
+  std::vector<run> runs; // in the order they were done; warmup excluded
+
+  summary wall_ms;
+  summary user_cpu_ms;
+  summary system_cpu_ms;
+  summary max_rss_kib;
+
+  // runs whose wall time lies outside of the Tukey's fences (`1.5` times the
+  // interquartile range below the 1st or above the 3rd quartile) - if there
+  // are many, something else probably interfered with the measurement
+  std::size_t wall_outliers;
+};
+
+// `runs` > 0; the `warmup` runs are done first & thrown away (e.g. to have the
+// page cache populated); throws `std::runtime_error` if any run fails to spawn
+// (or fails, see `measure_options::ignore_failures`)
+[[nodiscard]] measurement measure(std::string const &path,
+                                  std::vector<std::string> const &args,
+                                  int const runs, int const warmup = 0,
+                                  measure_options const &options = {});
+
+} // namespace exec_path_args::os_wrapper
@@ -28,7 +28,19 @@ struct pipe_helper {
 
   pipe_helper() noexcept = default;
 
-  void init();
+  // always `O_CLOEXEC` (so no other child spawned concurrently, e.g. from
+  // another thread, inherits it) & optionally other `flags` as in
+  // https://man7.org/linux/man-pages/man2/pipe.2.html
+  void init(int const flags = 0);
+
+  // https://man7.org/linux/man-pages/man2/fcntl.2.html (`F_SETPIPE_SZ`); the
+  // kernel rounds `bytes` up (to a power of 2 pages); unprivileged processes
+  // are limited by `/proc/sys/fs/pipe-max-size`
+  void set_capacity(int const bytes);
+
+  // `O_NONBLOCK` for the writing end only - the reading one goes to a child,
+  // which expects blocking reads
+  void set_nonblocking_in();
 
   ~pipe_helper() noexcept;
 
@@ -41,6 +53,10 @@ struct pipe_helper {
   void close_out() noexcept;
   void close_in() noexcept;
 
+  // gives up the ownership (the caller has to close it)
+  [[nodiscard]] native_fd_t release_out() noexcept;
+  [[nodiscard]] native_fd_t release_in() noexcept;
+
 private:
   pipe_helper(pipe_helper const &) = delete;
   pipe_helper &operator=(pipe_helper const &) = delete;
@@ -0,0 +1,375 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "exec_path_args/exec_path_args.hxx"
+#include "exec_path_args/latency_histogram.hxx"
+#include "exec_path_args/native_fd_t.hxx"
+#include "exec_path_args/process_handle_t.hxx"
+#include "exec_path_args/spawn_options.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+struct timer_wheel; // implementation detail
+
+// many children managed together - instead of `std::vector<exec_path_args>`
+// & looping over it; everything per child is kept in a struct-of-arrays table
+// (so e.g. scanning states touches only the states), and the collective
+// operations wait for all of the children at once - a single `epoll_wait` over
+// their pidfds & output pipes (followed only by `waitid`/`read` for those that
+// are actually ready)
+// children are identified by their index, given by `add`; stdout & stderr are
+// always drained (into per-child buffers) while waiting, so no child blocks on
+// a full pipe
+// NOT thread-safe
+struct process_group {
+  using index_t = std::uint32_t;
+  using state = exec_path_args::state;
+  using exit_reason = exec_path_args::exit_reason;
+
+  friend void swap(process_group &lhs, process_group &rhs) noexcept;
+
+  process_group() noexcept;
+
+  process_group(process_group &&rhs) noexcept;
+  process_group &operator=(process_group &&rhs) noexcept;
+
+  // still running children are killed, but not waited for (see
+  // `exec_path_args::~exec_path_args`)
+  ~process_group() noexcept;
+
+  void reserve(std::size_t const capacity);
+
+  // new child in `state::ready`; `options.extra_fds` may only pass parent's
+  // fds (not capture anything)
+  index_t add(std::string &&path, std::vector<std::string> &&args);
+  index_t add(std::string &&path, std::vector<std::string> &&args,
+              spawn_options &&options);
+  // `options` may be shared by many children (e.g. all of them)
+  index_t add(std::string &&path, std::vector<std::string> &&args,
+              std::shared_ptr<spawn_options const> options);
+
+  [[nodiscard]] std::size_t size() const noexcept { return t.states.size(); }
+  [[nodiscard]] std::size_t running() const noexcept { return num_running; }
+
+  // spawns children in `state::ready` - in phases, as `spawn_batch` does -
+  // until `max_count` of them started successfully (or none is left to try);
+  // returns what failed, ordered by index (those stay `state::ready`)
+  struct spawn_failure {
+    index_t index;
+    std::exception_ptr error;
+  };
+  std::vector<spawn_failure>
+  spawn_all(std::size_t const max_count =
+                std::numeric_limits<std::size_t>::max());
+  // a child in `state::ready` (e.g. one that failed to spawn) won't be spawned
+  // after all - it's left in `state::uninitialzied`, skipped by `spawn_all`
+  void cancel(index_t const i);
+
+  // waits (`timeout_ms` as for `exec_path_args::update_and_get_state`) until
+  // anything happens (a child terminates or writes something), then processes
+  // everything that's ready; returns how many children finished meanwhile
+  std::size_t update_all(int const timeout_ms = 0);
+
+  // `update_all(-1)` until nothing runs anymore (output pipes may still be
+  // open, e.g. inherited by a grandchild - see `collect_outputs`)
+  void finish_all();
+
+  // once the child runs for `timeout_ms` (counted from its spawn), it gets
+  // `SIGTERM` & then `SIGKILL` if it's still running `grace_ms` later; it ends
+  // up with `exit_reason::timed_out` either way
+  // deadlines are enforced only while the group is being waited on
+  // (`update_all` & co.), with a millisecond resolution
+  void set_deadline(index_t const i, int const timeout_ms,
+                    int const grace_ms = 1000);
+  // (a signal already sent stays sent)
+  void cancel_deadline(index_t const i);
+
+  // as `set_deadline`, but for a child that doesn't write anything (neither to
+  // stdout nor stderr) for `timeout_ms` - counted from its last output, its
+  // spawn or this call, whichever is the latest; it ends up with
+  // `exit_reason::inactive`
+  void set_inactivity_timeout(index_t const i, int const timeout_ms,
+                              int const grace_ms = 1000);
+  void cancel_inactivity_timeout(index_t const i);
+
+  // timing statistics per "command template" - the child's path, unless named
+  // otherwise by `set_template`; off by default (each template costs ~30 KiB)
+  struct command_stats {
+    latency_histogram spawn_ns;        // `fork` until `execv` succeeded
+    latency_histogram first_output_ns; // spawn until its first output byte
+    latency_histogram runtime_ns;      // spawn until it terminated
+  };
+  void enable_stats();
+  void set_template(index_t const i, std::string &&name);
+  [[nodiscard]] std::map<std::string, command_stats> stats() const;
+
+  // resource usage of a running child, read from its `/proc/<pid>/statm` &
+  // `/proc/<pid>/schedstat` (both way cheaper for the kernel to produce than
+  // `/proc/<pid>/stat`)
+  // https://man7.org/linux/man-pages/man5/proc_pid_statm.5.html
+  // https://docs.kernel.org/scheduler/sched-stats.html
+  struct resource_sample {
+    long long since_spawn_ns;
+    // on the CPU (user & system time together, in nanoseconds) - of its main
+    // thread only
+    long long cpu_ns;
+    long rss_kib;
+    long vm_size_kib;
+  };
+  // every child spawned afterwards gets sampled each `interval_ms` (while the
+  // group is being waited on, as the deadlines), keeping the last `capacity`
+  // samples; each sampled child holds two more fds (opened once, read with
+  // `pread`) - until it's reaped (an exited, unreaped one isn't sampled)
+  // NOTE: a sample still costs the parent a few microseconds (mostly the kernel
+  // touching cache-cold structures of the child) - e.g. 10k children sampled
+  // once a second take ~4% of a core, see the `resource_sampling` benchmark
+  void enable_sampling(int const interval_ms, std::size_t const capacity = 64);
+  // oldest first
+  [[nodiscard]] std::vector<resource_sample> samples(index_t const i) const;
+
+  // `SIGKILL`s every running child first, then waits for all of them
+  void kill_all();
+  void kill(index_t const i);
+
+  // reads everything currently available in the output pipes (without
+  // blocking); returns how many bytes were read
+  std::size_t collect_outputs();
+
+  // ordered
+  [[nodiscard]] std::vector<index_t> finished_indices() const;
+
+  // for finished children: reads whatever is left in their pipes (without
+  // blocking), closes them & trims their buffers; then trims the table itself
+  // - so lots of finished children kept around (e.g. until their output is
+  // collected) cost as little as possible; anything written later (e.g. by a
+  // grandchild) is lost
+  // NOTE: paths are stored only once (per distinct path) & `args`/options are
+  // released as soon as a child is spawned
+  void shrink_to_fit();
+
+  // as `exec_path_args::send_to_stdin` & `try_send_to_stdin` do
+  void send_to_stdin(index_t const i, std::string_view const data);
+  void send_to_stdin(index_t const i, std::string_view const *const pieces,
+                     std::size_t const count);
+  void send_to_stdin(index_t const i,
+                     std::initializer_list<std::string_view> const pieces) {
+    send_to_stdin(i, pieces.begin(), pieces.size());
+  }
+  [[nodiscard]] std::size_t try_send_to_stdin(index_t const i,
+                                              std::string_view const data);
+  [[nodiscard]] std::size_t
+  try_send_to_stdin(index_t const i, std::string_view const *const pieces,
+                    std::size_t const count);
+  void close_stdin(index_t const i);
+
+  // pull-based alternative to `send_to_stdin`: `producer` is called (while the
+  // group is being waited on, as the deadlines) whenever stdin of `i` has room,
+  // to fill `buffer` with up to `capacity` bytes; it returns how many it did,
+  // `0` ~ end of stream (stdin then gets closed) - so nothing piles up in the
+  // parent & a child not keeping up just isn't asked for more
+  // may be set before the child is spawned (unless with
+  // `spawn_options::stdin_fd`) or while it's running with stdin still open;
+  // don't mix it with `send_to_stdin`; whatever it throws is propagated; a
+  // child not reading its stdin anymore also ends the stream (no `SIGPIPE`)
+  using stdin_producer = std::function<std::size_t(
+      char *const buffer, std::size_t const capacity)>;
+  void set_stdin_producer(index_t const i, stdin_producer &&producer);
+
+  // buffered output, since spawning or the last `get_...` call
+  [[nodiscard]] std::string_view read_stdout(index_t const i) const;
+  [[nodiscard]] std::string_view read_stderr(index_t const i) const;
+  [[nodiscard]] std::string get_stdout(index_t const i);
+  [[nodiscard]] std::string get_stderr(index_t const i);
+
+  [[nodiscard]] state get_state(index_t const i) const;
+  [[nodiscard]] process_handle_t get_process_handle(index_t const i) const;
+  // see `exec_path_args::get_return_code` & `get_exit_reason`
+  [[nodiscard]] int get_return_code(index_t const i) const;
+  [[nodiscard]] exit_reason get_exit_reason(index_t const i) const;
+  // see `exec_path_args::time_running_ms`
+  [[nodiscard]] double time_running_ms(index_t const i) const;
+
+private:
+  process_group(process_group const &) = delete;
+  process_group &operator=(process_group const &) = delete;
+
+  // which fd an `epoll` event is about
+  enum class source : std::uint64_t {
+    pid_fd,
+    stdout_pipe,
+    stderr_pipe,
+    stdin_pipe // (only with a `stdin_producer`)
+  };
+
+  // bits of `table::flags`
+  static std::uint8_t constexpr kill_requested{1 << 0};
+  static std::uint8_t constexpr cpu_limited{1 << 1}; // see `classify_exit`
+  static std::uint8_t constexpr timed_out{1 << 2};   // `SIGTERM` sent
+  static std::uint8_t constexpr inactive{1 << 3};    // ... for inactivity
+  static std::uint8_t constexpr got_output{1 << 4};
+  static std::uint8_t constexpr inactivity_set{1 << 5}; // see `inactivity`
+
+  // timers of a child `i` have ids `i * timer_kinds + kind`
+  // (once timed out, `deadline` is the one to send `SIGKILL`)
+  enum class timer_kind : std::uint32_t { deadline, inactivity, sampling };
+  static std::uint32_t constexpr timer_kinds{3};
+
+  struct table {
+    // hot - touched by the collective operations
+    std::vector<state> states;
+    std::vector<std::uint8_t> flags;
+    std::vector<process_handle_t> pids;
+    std::vector<native_fd_t> pid_fds;
+    std::vector<long long> spawned_ns;
+    std::vector<long long> finished_ns;
+    std::vector<int> return_codes;
+    std::vector<exit_reason> reasons;
+    // `-1` ~ none
+    std::vector<int> deadlines_ms;
+    std::vector<int> grace_periods_ms;
+
+    // parent's ends of the pipes (once running) & where the output goes
+    std::vector<native_fd_t> stdin_fds;
+    std::vector<native_fd_t> stdout_fds;
+    std::vector<native_fd_t> stderr_fds;
+    std::vector<std::string> stdout_buffers;
+    std::vector<std::string> stderr_buffers;
+
+    // into `interned_paths`
+    std::vector<std::uint32_t> template_ids;
+  };
+  table t;
+
+  // the rest is needed only by some children (or only for a while), so it's
+  // kept aside - keyed by index - instead of in a column each
+
+  // needed only until spawned (or cancelled)
+  struct spawn_inputs {
+    std::uint32_t path_id; // into `interned_paths`
+    std::vector<std::string> args;
+    // `nullptr` ~ default options
+    std::shared_ptr<spawn_options const> options;
+  };
+  std::unordered_map<index_t, spawn_inputs> inputs;
+
+  // present ~ its stdin is watched (once running)
+  struct stdin_feed {
+    stdin_producer producer;
+    std::string pending; // produced, but didn't fit into the pipe yet
+  };
+  std::unordered_map<index_t, stdin_feed> stdin_feeds;
+
+  // present ~ `inactivity_set` (in `table::flags`)
+  struct inactivity_timeout {
+    int timeout_ms;
+    int grace_period_ms;
+    long long last_output_ns{0}; // (once running)
+  };
+  std::unordered_map<index_t, inactivity_timeout> inactivity;
+
+  // `/proc/<pid>/statm` & `schedstat` (only while sampled) & a ring of the
+  // samples - its size fixed at spawn, `count` ~ how many were taken in total
+  struct sampled_child {
+    native_fd_t statm_fd{invalid_fd};
+    native_fd_t schedstat_fd{invalid_fd};
+    std::vector<resource_sample> ring;
+    std::uint32_t count{0};
+  };
+  std::unordered_map<index_t, sampled_child> sampled;
+
+  // each distinct path (or template name) is stored only once
+  std::unordered_map<std::string, std::uint32_t> path_ids_by_name;
+  std::vector<std::string const *> interned_paths;
+
+  bool stats_enabled{false};
+  // by template id, created once needed
+  std::vector<std::unique_ptr<command_stats>> stats_by_template;
+
+  int sampling_interval_ms{-1}; // `-1` ~ off
+  std::size_t sampling_capacity{0};
+
+  native_fd_t epoll_fd{invalid_fd};
+  std::size_t num_running{0};
+  std::size_t num_watched{0}; // fds registered in `epoll_fd`
+  index_t first_ready{0};     // no `state::ready` child before this one
+  // in milliseconds of `now_ns`; created on the first `set_deadline` (or
+  // `set_inactivity_timeout`, `enable_sampling`)
+  std::unique_ptr<timer_wheel> timers;
+
+  [[nodiscard]] std::uint32_t intern(std::string &&path);
+  void check_index(index_t const i) const;
+  // throws unless stdin of `i` can be written to
+  void check_stdin(index_t const i) const;
+  // `nullptr` unless `stats_enabled`
+  [[nodiscard]] command_stats *stats_of(index_t const i);
+  void watch(native_fd_t const fd, index_t const i, source const what);
+  // removes it from `epoll_fd` & closes it
+  void unwatch(native_fd_t &fd) noexcept;
+
+  void arm_timer(index_t const i, timer_kind const kind,
+                 long long const expiry_ms);
+  void cancel_timer(index_t const i, timer_kind const kind) noexcept;
+  // moves `timers` to now, handling whatever expires meanwhile
+  void expire_timers();
+  void on_deadline(index_t const i);
+  // not re-armed on every output - only when it expires, if there was any
+  // output meanwhile
+  void on_inactivity(index_t const i);
+  // sends `SIGTERM` & arms the `SIGKILL` one
+  void time_out(index_t const i, int const grace_ms);
+  // takes a sample & re-arms itself
+  void on_sampling(index_t const i);
+  [[nodiscard]] long long next_sampling_ms(long long const now_ms) const;
+
+  void spawn_chunk(std::vector<index_t> const &chunk,
+                   std::vector<spawn_failure> &failures);
+
+  struct processed {
+    std::size_t events{0};
+    std::size_t finished{0};
+    std::size_t bytes_read{0};
+  };
+  processed process_events(int const timeout_ms);
+  // reaps it (`block == false` -> only if it has already terminated); returns
+  // whether it did
+  bool on_exit(index_t const i, bool const block = false);
+  // returns how many bytes were read
+  std::size_t on_output(index_t const i, source const what);
+  // returns how many bytes were written
+  std::size_t on_stdin(index_t const i, std::uint32_t const events);
+  // closes stdin (if still open) & drops its producer (if any)
+  void end_stdin(index_t const i) noexcept;
+};
+
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,234 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "exec_path_args/futex.hxx"
+#include "exec_path_args/spawn_options.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+// parent <-> child synchronization: a counting semaphore each way, in a page
+// of shared memory - waiting sleeps on a futex (with `CLOCK_MONOTONIC`
+// timeouts, so not affected by setting the clock), notifying only enters the
+// kernel if the other side actually sleeps
+// backed by a `memfd` passed to the child the same way as `shm_ring` is (an
+// inherited fd announced by an environment variable) - no global names to
+// agree on or clean up after a crash, unlike POSIX named semaphores
+// the side calling `create` is the parent, the one calling `attach` (or
+// `from_environment`) the child - each waits for what the other one notifies
+// header-only - so child programs need nothing else (no linking)
+struct rendezvous {
+  static constexpr char const default_variable[]{"EXEC_PATH_ARGS_RENDEZVOUS"};
+
+  // throws `std::runtime_error` on failure
+  [[nodiscard]] static rendezvous create() {
+    rendezvous r;
+    // https://man7.org/linux/man-pages/man2/memfd_create.2.html
+    r.shared_fd = static_cast<int>(
+        syscall(static_cast<long>(SYS_memfd_create),
+                "exec_path_args_rendezvous", MFD_CLOEXEC));
+    if (r.shared_fd == -1) {
+      fail("cannot create rendezvous");
+    }
+    if (ftruncate(r.shared_fd, static_cast<off_t>(sizeof(control))) == -1) {
+      fail("cannot size rendezvous");
+    }
+    r.map();
+    r.shared = new (r.shared) control{};
+    r.shared->magic = control::expected_magic;
+    r.to_wait = &r.shared->to_parent;
+    r.to_notify = &r.shared->to_child;
+    return r;
+  }
+
+  // maps a rendezvous created elsewhere, taking over `fd`; throws
+  // `std::runtime_error` if it isn't one
+  [[nodiscard]] static rendezvous attach(int const fd) {
+    rendezvous r;
+    r.shared_fd = fd;
+    struct stat st {};
+    if (fstat(fd, &st) == -1) {
+      fail("cannot attach rendezvous");
+    }
+    if (static_cast<std::size_t>(st.st_size) != sizeof(control)) {
+      throw std::runtime_error{"cannot attach rendezvous - unexpected size!"};
+    }
+    r.map();
+    r.shared = std::launder(r.shared);
+    if (r.shared->magic != control::expected_magic) {
+      throw std::runtime_error{"cannot attach rendezvous - it isn't one!"};
+    }
+    r.to_wait = &r.shared->to_child;
+    r.to_notify = &r.shared->to_parent;
+    return r;
+  }
+
+  // in the child - the rendezvous the parent passed to it
+  [[nodiscard]] static rendezvous
+  from_environment(char const *const variable = default_variable) {
+    char const *const value{std::getenv(variable)};
+    if (value == nullptr) {
+      throw std::runtime_error{std::string{"cannot attach rendezvous - no "} +
+                               variable + " in the environment!"};
+    }
+    return attach(std::atoi(value));
+  }
+
+  // in the parent - the child gets it as `child_fd` (see
+  // `spawn_options::extra_fds`), announced by `variable`; the rendezvous must
+  // outlive the spawn
+  void pass_to(spawn_options &options, int const child_fd,
+               std::string_view const variable = default_variable) const {
+    options.extra_fds.push_back({child_fd, shared_fd});
+    options.environment.push_back(std::string{variable} + '=' +
+                                  std::to_string(child_fd));
+  }
+
+  rendezvous() noexcept = default;
+
+  rendezvous(rendezvous &&rhs) noexcept
+      : shared_fd{std::exchange(rhs.shared_fd, -1)},
+        shared{std::exchange(rhs.shared, nullptr)},
+        to_wait{std::exchange(rhs.to_wait, nullptr)},
+        to_notify{std::exchange(rhs.to_notify, nullptr)} {}
+
+  rendezvous &operator=(rendezvous &&rhs) noexcept {
+    if (this != &rhs) {
+      rendezvous tmp{std::move(rhs)};
+      std::swap(shared_fd, tmp.shared_fd);
+      std::swap(shared, tmp.shared);
+      std::swap(to_wait, tmp.to_wait);
+      std::swap(to_notify, tmp.to_notify);
+    }
+    return *this;
+  }
+
+  ~rendezvous() noexcept {
+    if (shared != nullptr) {
+      munmap(shared, sizeof(control));
+    }
+    if (shared_fd != -1) {
+      ::close(shared_fd);
+    }
+  }
+
+  [[nodiscard]] int fd() const noexcept { return shared_fd; }
+
+  // waits (`timeout_ms` as for `poll`: `-1` ~ forever, `0` ~ not at all) for
+  // a notification from the other side & consumes it; returns `false` on
+  // timeout
+  [[nodiscard]] bool wait(int const timeout_ms) {
+    auto &s{*to_wait};
+    auto const deadline_ns{futex::deadline_after(timeout_ms)};
+    bool timed_out{timeout_ms == 0};
+    while (true) {
+      auto count{s.count.load(std::memory_order_seq_cst)};
+      while (count != 0) {
+        if (s.count.compare_exchange_weak(count, count - 1,
+                                          std::memory_order_seq_cst)) {
+          return true;
+        }
+      }
+      if (timed_out) {
+        return false;
+      }
+      s.sleeping.fetch_add(1, std::memory_order_seq_cst);
+      // (returns right away if notified meanwhile)
+      timed_out = !futex::wait(s.count, 0, deadline_ns);
+      s.sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  void notify() {
+    auto &s{*to_notify};
+    s.count.fetch_add(1, std::memory_order_seq_cst);
+    if (s.sleeping.load(std::memory_order_seq_cst) != 0) {
+      futex::wake(s.count, 1);
+    }
+  }
+
+  [[nodiscard]] bool notify_and_wait(int const timeout_ms) {
+    notify();
+    return wait(timeout_ms);
+  }
+
+  [[nodiscard]] bool wait_and_notify(int const timeout_ms) {
+    bool const res{wait(timeout_ms)};
+    notify();
+    return res;
+  }
+
+private:
+  rendezvous(rendezvous const &) = delete;
+  rendezvous &operator=(rendezvous const &) = delete;
+
+  // each direction in its own cache line
+  struct control {
+    static std::uint64_t constexpr expected_magic{0x4550'4152'4456'5331};
+
+    struct semaphore {
+      std::atomic<std::uint32_t> count{0}; // the futex
+      std::atomic<std::uint32_t> sleeping{0};
+    };
+
+    std::uint64_t magic;
+    alignas(64) semaphore to_child;
+    alignas(64) semaphore to_parent;
+  };
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+  int shared_fd{-1};
+  control *shared{nullptr};
+  control::semaphore *to_wait{nullptr};
+  control::semaphore *to_notify{nullptr};
+
+  [[noreturn]] static void fail(char const *const what) {
+    throw std::runtime_error{std::string{what} + " - " +
+                             std::strerror(errno) + "!"};
+  }
+
+  void map() {
+    auto *const mapped{mmap(nullptr, sizeof(control), PROT_READ | PROT_WRITE,
+                            MAP_SHARED, shared_fd, 0)};
+    if (mapped == MAP_FAILED) {
+      fail("cannot map rendezvous");
+    }
+    shared = static_cast<control *>(mapped);
+  }
+};
+
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,158 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "exec_path_args/native_fd_t.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+// an append-only log of finished runs, for offline analysis (& replaying them)
+// - two files: `<path>` holds a small header followed by fixed-size
+// `run_record`s, `<path>.strings` the string table they point into; both are
+// in the host's byte order (not meant to be moved between architectures)
+// readers `mmap` them & use the records in place - no parsing at all; see
+// `tools/run_log_to_csv.cxx`
+struct run_record {
+  // into the string table: the path & then the arguments, each one terminated
+  // by `'\0'` (identical commands are stored only once per writer)
+  std::uint64_t command_offset;
+  std::uint32_t command_size;
+  std::int32_t return_code; // or the signal number, see `exit_reason`
+  // of any clock, as long as it's the same for the whole log (e.g.
+  // `CLOCK_REALTIME`, to correlate it with anything else)
+  std::int64_t start_ns;
+  std::int64_t end_ns;
+  std::int64_t user_cpu_ns;
+  std::int64_t system_cpu_ns;
+  std::int64_t max_rss_kib;
+  std::uint64_t stdout_bytes;
+  std::uint64_t stderr_bytes;
+  std::uint8_t exit_reason; // `exec_path_args::exit_reason`
+  std::uint8_t reserved[7];
+};
+static_assert(sizeof(run_record) == 80);
+
+// `append` only copies into a buffer; a background thread writes the filled
+// ones out (the strings before the records pointing into them, so the log is
+// consistent at any time - at worst with a partial record at its end, which
+// readers ignore)
+// thread-safe
+struct run_log_writer {
+  // creates the files, or appends to existing ones; throws
+  // `std::runtime_error` on failure
+  explicit run_log_writer(std::string const &path,
+                          std::size_t const buffer_bytes = 256 * 1024);
+
+  // flushes everything
+  ~run_log_writer() noexcept;
+
+  // fills in `record.command_*`; throws `std::runtime_error` if any previous
+  // write failed
+  void append(std::string_view const path, std::vector<std::string> const &args,
+              run_record record);
+
+  // blocks until everything appended so far is written; throws as `append`
+  void flush();
+
+private:
+  run_log_writer(run_log_writer const &) = delete;
+  run_log_writer &operator=(run_log_writer const &) = delete;
+  run_log_writer(run_log_writer &&) = delete;
+  run_log_writer &operator=(run_log_writer &&) = delete;
+
+  struct chunk {
+    std::string strings;
+    std::string records;
+  };
+
+  void write_in_background() noexcept;
+  // the lock is held
+  void hand_over(std::unique_lock<std::mutex> &lck);
+  void rethrow_any_error() const;
+
+  std::size_t const buffer_bytes;
+  native_fd_t records_fd{invalid_fd};
+  native_fd_t strings_fd{invalid_fd};
+
+  mutable std::mutex mtx;
+  std::condition_variable work_available;
+  std::condition_variable work_done;
+  bool stopping{false};
+  chunk filling; // by `append`
+  chunk writing; // by the background thread
+  bool writing_pending{false};
+  std::exception_ptr error;
+
+  std::uint64_t strings_size{0}; // including what's buffered
+  std::unordered_map<std::string, std::uint64_t> command_offsets;
+
+  std::thread writer;
+};
+
+// the log as it was when opened (anything appended later isn't seen)
+struct run_log_reader {
+  // throws `std::runtime_error` if it can't be mapped, or isn't a run log
+  explicit run_log_reader(std::string const &path);
+  ~run_log_reader() noexcept;
+
+  [[nodiscard]] std::size_t size() const noexcept { return num_records; }
+  [[nodiscard]] run_record const *begin() const noexcept { return records; }
+  [[nodiscard]] run_record const *end() const noexcept {
+    return records + num_records;
+  }
+  [[nodiscard]] run_record const &operator[](std::size_t const i) const {
+    return records[i];
+  }
+
+  // `'\0'`-separated, see `run_record::command_offset`
+  [[nodiscard]] std::string_view command_of(run_record const &record) const;
+  // split
+  [[nodiscard]] std::vector<std::string_view>
+  command_parts_of(run_record const &record) const;
+
+private:
+  run_log_reader(run_log_reader const &) = delete;
+  run_log_reader &operator=(run_log_reader const &) = delete;
+  run_log_reader(run_log_reader &&) = delete;
+  run_log_reader &operator=(run_log_reader &&) = delete;
+
+  void unmap() noexcept;
+
+  void *records_map{nullptr};
+  std::size_t records_map_size{0};
+  void *strings_map{nullptr};
+  std::size_t strings_map_size{0};
+
+  run_record const *records{nullptr};
+  std::size_t num_records{0};
+};
+
+} // namespace exec_path_args::os_wrapper
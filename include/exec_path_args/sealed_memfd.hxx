@@ -0,0 +1,38 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <string_view>
+
+#include "exec_path_args/native_fd_t.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+// a memfd holding (a copy of) `data`, sealed against any further changes &
+// positioned at its start - e.g. for `spawn_options::stdin_fd`, so a child
+// reads a buffer of the parent as a file, instead of the parent pushing it
+// through a pipe (`send_to_stdin`) while the child runs
+// `name` only shows up in `/proc/<pid>/fd/`; the caller owns (closes) the
+// returned fd; throws `std::runtime_error` on failure
+// https://man7.org/linux/man-pages/man2/memfd_create.2.html
+[[nodiscard]] native_fd_t sealed_memfd(std::string_view const data,
+                                       char const *const name = "stdin");
+
+} // namespace exec_path_args::os_wrapper
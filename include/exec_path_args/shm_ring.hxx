@@ -0,0 +1,366 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "exec_path_args/futex.hxx"
+#include "exec_path_args/spawn_options.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+// single-producer single-consumer byte ring in shared memory - for children
+// exchanging lots of data with the parent, without a pipe's ~64 KiB per
+// wakeup & copying everything through the kernel twice
+// backed by a `memfd` (passed to the child as an inherited fd, announced by an
+// environment variable - see `pass_to` & `from_environment`), its data mapped
+// twice back to back - so whatever is readable (or writable) is contiguous &
+// can be used in place; a side waiting for the other one sleeps on a futex in
+// the shared memory (only woken if it actually sleeps)
+// one ring ~ one direction, either end may be in either process (& each end
+// must be used by a single thread at a time)
+// header-only - so child programs need nothing else (no linking)
+struct shm_ring {
+  static constexpr char const default_variable[]{"EXEC_PATH_ARGS_SHM_RING"};
+
+  struct writable_span {
+    char *data;
+    std::size_t size;
+  };
+
+  // `capacity` (in bytes) is rounded up to whole pages; throws
+  // `std::runtime_error` on failure
+  [[nodiscard]] static shm_ring create(std::size_t const capacity) {
+    shm_ring ring;
+    // https://man7.org/linux/man-pages/man2/memfd_create.2.html
+    ring.ring_fd = static_cast<int>(syscall(
+        static_cast<long>(SYS_memfd_create), "exec_path_args_shm_ring",
+        MFD_CLOEXEC));
+    if (ring.ring_fd == -1) {
+      fail("cannot create shared memory ring");
+    }
+    auto const page{page_size()};
+    ring.data_size = (std::max<std::size_t>(capacity, 1) + page - 1) / page *
+                     page;
+    if (ftruncate(ring.ring_fd, static_cast<off_t>(page + ring.data_size)) ==
+        -1) {
+      fail("cannot size shared memory ring");
+    }
+    ring.map();
+    auto *const c{new (ring.base) control{}};
+    c->magic = control::expected_magic;
+    c->capacity = ring.data_size;
+    return ring;
+  }
+
+  // maps a ring created elsewhere, taking over `fd`; throws
+  // `std::runtime_error` if it isn't one
+  [[nodiscard]] static shm_ring attach(int const fd) {
+    shm_ring ring;
+    ring.ring_fd = fd;
+    struct stat st {};
+    if (fstat(fd, &st) == -1) {
+      fail("cannot attach shared memory ring");
+    }
+    auto const page{page_size()};
+    auto const size{static_cast<std::size_t>(st.st_size)};
+    if ((size <= page) || ((size % page) != 0)) {
+      throw std::runtime_error{
+          "cannot attach shared memory ring - unexpected size!"};
+    }
+    ring.data_size = size - page;
+    ring.map();
+    if ((ring.ctl().magic != control::expected_magic) ||
+        (ring.ctl().capacity != ring.data_size)) {
+      throw std::runtime_error{
+          "cannot attach shared memory ring - it isn't one!"};
+    }
+    return ring;
+  }
+
+  // in the child - the ring the parent passed to it
+  [[nodiscard]] static shm_ring
+  from_environment(char const *const variable = default_variable) {
+    char const *const value{std::getenv(variable)};
+    if (value == nullptr) {
+      throw std::runtime_error{std::string{"cannot attach shared memory ring "
+                                           "- no "} +
+                               variable + " in the environment!"};
+    }
+    return attach(std::atoi(value));
+  }
+
+  // in the parent - the child gets it as `child_fd` (see
+  // `spawn_options::extra_fds`), announced by `variable`; the ring must
+  // outlive the spawn
+  void pass_to(spawn_options &options, int const child_fd,
+               std::string_view const variable = default_variable) const {
+    options.extra_fds.push_back({child_fd, ring_fd});
+    options.environment.push_back(std::string{variable} + '=' +
+                                  std::to_string(child_fd));
+  }
+
+  shm_ring() noexcept = default;
+
+  shm_ring(shm_ring &&rhs) noexcept
+      : ring_fd{std::exchange(rhs.ring_fd, -1)},
+        base{std::exchange(rhs.base, nullptr)},
+        data_size{std::exchange(rhs.data_size, 0)} {}
+
+  shm_ring &operator=(shm_ring &&rhs) noexcept {
+    if (this != &rhs) {
+      shm_ring tmp{std::move(rhs)};
+      std::swap(ring_fd, tmp.ring_fd);
+      std::swap(base, tmp.base);
+      std::swap(data_size, tmp.data_size);
+    }
+    return *this;
+  }
+
+  ~shm_ring() noexcept {
+    if (base != nullptr) {
+      munmap(base, page_size() + 2 * data_size);
+    }
+    if (ring_fd != -1) {
+      ::close(ring_fd);
+    }
+  }
+
+  [[nodiscard]] int fd() const noexcept { return ring_fd; }
+  [[nodiscard]] std::size_t capacity() const noexcept { return data_size; }
+
+  // producer:
+
+  // waits (`timeout_ms` as for `poll`: `-1` ~ forever, `0` ~ not at all) until
+  // anything is free; returns all that's free (empty on timeout)
+  // NOTE: this & the other accessors throw `std::runtime_error` if the ring is
+  // broken (see `used`)
+  [[nodiscard]] writable_span writable(int const timeout_ms = -1) {
+    auto &c{ctl()};
+    auto const head{c.head.load(std::memory_order_relaxed)};
+    auto const free_bytes = [&] {
+      return data_size - used(head, c.tail.load(std::memory_order_seq_cst));
+    };
+    if (!wait_until(c.space_signal, c.producer_sleeping, timeout_ms,
+                    [&] { return free_bytes() != 0; })) {
+      return {nullptr, 0};
+    }
+    return {data() + head % data_size, free_bytes()};
+  }
+
+  // makes the first `size` bytes of `writable` readable
+  void commit(std::size_t const size) {
+    auto &c{ctl()};
+    auto const head{c.head.load(std::memory_order_relaxed)};
+    if (data_size - used(head, c.tail.load(std::memory_order_seq_cst)) <
+        size) {
+      throw std::runtime_error{
+          "cannot commit to shared memory ring - more than is writable!"};
+    }
+    c.head.store(head + size, std::memory_order_seq_cst);
+    notify(c.data_signal, c.consumer_sleeping);
+  }
+
+  void write_all(std::string_view data) {
+    while (!data.empty()) {
+      auto const span{writable()};
+      auto const n{std::min(span.size, data.size())};
+      std::memcpy(span.data, data.data(), n);
+      commit(n);
+      data.remove_prefix(n);
+    }
+  }
+
+  // no more data (the consumer gets `eof` once it reads everything)
+  void close() {
+    auto &c{ctl()};
+    c.closed.store(1, std::memory_order_seq_cst);
+    notify(c.data_signal, c.consumer_sleeping);
+  }
+
+  // consumer:
+
+  // waits (as `writable` does) until anything is readable (or it's closed);
+  // returns all that's readable (empty on timeout or `eof`)
+  [[nodiscard]] std::string_view readable(int const timeout_ms = -1) {
+    auto &c{ctl()};
+    auto const tail{c.tail.load(std::memory_order_relaxed)};
+    auto const available = [&] {
+      return used(c.head.load(std::memory_order_seq_cst), tail);
+    };
+    if (!wait_until(c.data_signal, c.consumer_sleeping, timeout_ms, [&] {
+          return (available() != 0) ||
+                 (c.closed.load(std::memory_order_seq_cst) != 0);
+        })) {
+      return {};
+    }
+    return {data() + tail % data_size, available()};
+  }
+
+  // frees the first `size` bytes of `readable`
+  void release(std::size_t const size) {
+    auto &c{ctl()};
+    auto const tail{c.tail.load(std::memory_order_relaxed)};
+    if (used(c.head.load(std::memory_order_seq_cst), tail) < size) {
+      throw std::runtime_error{
+          "cannot release from shared memory ring - more than is readable!"};
+    }
+    c.tail.store(tail + size, std::memory_order_seq_cst);
+    notify(c.space_signal, c.producer_sleeping);
+  }
+
+  // closed & everything read
+  [[nodiscard]] bool eof() const {
+    auto const &c{ctl()};
+    return (c.closed.load(std::memory_order_seq_cst) != 0) &&
+           (c.head.load(std::memory_order_seq_cst) ==
+            c.tail.load(std::memory_order_relaxed));
+  }
+
+private:
+  shm_ring(shm_ring const &) = delete;
+  shm_ring &operator=(shm_ring const &) = delete;
+
+  // in the first page; producer's & consumer's parts in separate cache lines
+  struct control {
+    static std::uint64_t constexpr expected_magic{0x5045'4152'494e'4731};
+
+    std::uint64_t magic;
+    std::uint64_t capacity;
+    alignas(64) std::atomic<std::uint64_t> head{0}; // written so far
+    std::atomic<std::uint32_t> data_signal{0};      // the futexes
+    std::atomic<std::uint32_t> consumer_sleeping{0};
+    std::atomic<std::uint32_t> closed{0};
+    alignas(64) std::atomic<std::uint64_t> tail{0}; // read so far
+    std::atomic<std::uint32_t> space_signal{0};
+    std::atomic<std::uint32_t> producer_sleeping{0};
+  };
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+                std::atomic<std::uint32_t>::is_always_lock_free);
+
+  int ring_fd{-1};
+  char *base{nullptr}; // the control page, followed by the data twice
+  std::size_t data_size{0};
+
+  [[noreturn]] static void fail(char const *const what) {
+    throw std::runtime_error{std::string{what} + " - " +
+                             std::strerror(errno) + "!"};
+  }
+
+  [[nodiscard]] static std::size_t page_size() noexcept {
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  }
+
+  [[nodiscard]] control &ctl() noexcept {
+    return *std::launder(reinterpret_cast<control *>(base));
+  }
+  [[nodiscard]] control const &ctl() const noexcept {
+    return *std::launder(reinterpret_cast<control const *>(base));
+  }
+  [[nodiscard]] char *data() noexcept { return base + page_size(); }
+
+  // how much is written, but not read yet - `head` & `tail` are in memory the
+  // other side (e.g. a buggy child) can write anything into, so whatever
+  // doesn't fit into the ring means it's broken (throws then)
+  [[nodiscard]] std::size_t used(std::uint64_t const head,
+                                 std::uint64_t const tail) const {
+    auto const n{head - tail}; // (a `tail` ahead of `head` wraps around)
+    if (n > data_size) {
+      throw std::runtime_error{
+          "broken shared memory ring - inconsistent head & tail!"};
+    }
+    return static_cast<std::size_t>(n);
+  }
+
+  void map() {
+    auto const page{page_size()};
+    // reserve the whole range first, then map the file over it - the data
+    // part twice
+    auto *const reserved{mmap(nullptr, page + 2 * data_size, PROT_NONE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+    if (reserved == MAP_FAILED) {
+      fail("cannot map shared memory ring");
+    }
+    base = static_cast<char *>(reserved);
+    if ((mmap(base, page + data_size, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_FIXED, ring_fd, 0) == MAP_FAILED) ||
+        (mmap(base + page + data_size, data_size, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_FIXED, ring_fd, static_cast<off_t>(page)) ==
+         MAP_FAILED)) {
+      fail("cannot map shared memory ring");
+    }
+  }
+
+  template <typename ready_t>
+  static bool wait_until(std::atomic<std::uint32_t> &signal,
+                         std::atomic<std::uint32_t> &sleeping,
+                         int const timeout_ms, ready_t const &ready) {
+    if (ready()) {
+      return true;
+    } else if (timeout_ms == 0) {
+      return false;
+    }
+
+    auto const deadline_ns{futex::deadline_after(timeout_ms)};
+    while (true) {
+      auto const seen{signal.load(std::memory_order_seq_cst)};
+      sleeping.store(1, std::memory_order_seq_cst);
+      if (ready()) {
+        sleeping.store(0, std::memory_order_relaxed);
+        return true;
+      }
+      // (returns right away if `signal` changed meanwhile)
+      bool const waited{futex::wait(signal, seen, deadline_ns)};
+      sleeping.store(0, std::memory_order_relaxed);
+      if (ready()) {
+        return true;
+      } else if (!waited) {
+        return false;
+      }
+    }
+  }
+
+  static void notify(std::atomic<std::uint32_t> &signal,
+                     std::atomic<std::uint32_t> &sleeping) {
+    signal.fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_seq_cst) != 0) {
+      futex::wake(signal, 1);
+    }
+  }
+};
+
+} // namespace exec_path_args::os_wrapper
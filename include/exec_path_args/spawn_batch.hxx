@@ -0,0 +1,49 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+#include "exec_path_args/exec_path_args.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+// spawns all `cmds` (each must be in `state::ready`) - the same as calling
+// `update_and_get_state()` on each of them, but in phases:
+// 1. everything (options, pipes, ...) is prepared & all `argv`s are built in a
+//    single allocation,
+// 2. all children are `fork`ed back to back,
+// 3. only then it waits for each of them to `execv` (so those overlap);
+// with `1 < num_threads`, `cmds` are split into that many contiguous chunks,
+// each spawned (as above) by its own thread
+// returns per-item results: `nullptr` on success, otherwise what
+// `update_and_get_state` would have thrown (the item stays `state::ready`)
+[[nodiscard]] std::vector<std::exception_ptr>
+spawn_batch(exec_path_args *const cmds, std::size_t const count,
+            int const num_threads = 1);
+
+[[nodiscard]] inline std::vector<std::exception_ptr>
+spawn_batch(std::vector<exec_path_args> &cmds, int const num_threads = 1) {
+  return spawn_batch(cmds.data(), cmds.size(), num_threads);
+}
+
+} // namespace exec_path_args::os_wrapper
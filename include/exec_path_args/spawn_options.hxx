@@ -0,0 +1,125 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <sys/resource.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "exec_path_args/native_fd_t.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+struct wait_tuner;
+
+// everything in here is applied by the child process itself - after `fork` and
+// before `execv`; if any of it fails, the child doesn't `execv` at all and the
+// error is reported back to the parent (`update_and_get_state` throws)
+struct spawn_options {
+  enum class scheduling_policy : char { inherit, other, batch, idle };
+  enum class io_priority_class : char { inherit, realtime, best_effort, idle };
+  enum class memory_policy : char {
+    inherit,
+    local,
+    preferred,
+    bind,
+    interleave
+  };
+
+  // https://man7.org/linux/man-pages/man2/sched_setaffinity.2.html
+  // empty -> inherited from the parent
+  std::vector<int> cpu_affinity;
+
+  // https://man7.org/linux/man-pages/man2/set_mempolicy.2.html
+  // `numa_nodes` is ignored for `inherit` & `local`
+  memory_policy numa_policy{memory_policy::inherit};
+  std::vector<int> numa_nodes;
+
+  // https://man7.org/linux/man-pages/man2/setpriority.2.html
+  std::optional<int> nice_value;
+
+  // https://man7.org/linux/man-pages/man2/ioprio_set.2.html
+  // `io_priority_level`: 0 (highest) ... 7 (lowest), ignored for `idle`
+  io_priority_class io_priority{io_priority_class::inherit};
+  int io_priority_level{4};
+
+  // https://man7.org/linux/man-pages/man7/sched.7.html
+  scheduling_policy scheduling{scheduling_policy::inherit};
+
+  // https://man7.org/linux/man-pages/man2/setrlimit.2.html
+  // e.g. `{RLIMIT_CPU, 10, 12}`; use `RLIM_INFINITY` for "unlimited"; see also
+  // `exec_path_args::get_exit_reason`
+  struct resource_limit {
+    int resource;
+    rlim_t soft;
+    rlim_t hard;
+  };
+  std::vector<resource_limit> resource_limits;
+
+  [[nodiscard]] bool limits(int const resource) const {
+    for (auto const &limit : resource_limits) {
+      if (limit.resource == resource) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // file descriptors the child gets besides stdin, stdout & stderr; nothing
+  // else is inherited from the parent
+  struct extra_fd {
+    int child_fd; // above `STDERR_FILENO`, unique
+    // - `invalid_fd` -> a new pipe; whatever the child writes into `child_fd`
+    // is captured, see `exec_path_args::read_extra_output`
+    // - otherwise passed to the child as is (the parent keeps its ownership)
+    native_fd_t parent_fd{invalid_fd};
+  };
+  std::vector<extra_fd> extra_fds;
+
+  // if set, the child's stdin is this fd as is - e.g. an open file, or a memfd
+  // (see `sealed_memfd`) - instead of a pipe the parent has to copy everything
+  // through (`send_to_stdin` & `close_stdin` then throw); the parent keeps its
+  // ownership, but its file offset is shared with the child - so each child
+  // needs an fd of its own (e.g. reopened through `/proc/self/fd/<fd>`)
+  native_fd_t stdin_fd{invalid_fd};
+
+  // `"NAME=value"` entries added to the environment inherited from the parent
+  // (replacing any variable of the same name)
+  std::vector<std::string> environment;
+
+  // (unlike the rest, these are applied by the parent)
+  // in bytes, `0` ~ system default; see `pipe_helper::set_capacity`
+  int stdin_pipe_capacity{0};
+  int stdout_pipe_capacity{0};
+  int stderr_pipe_capacity{0};
+
+  // stdout & stderr of the child go to `/dev/null` instead of pipes (e.g. for
+  // benchmarking it, see `measure`); reading them then yields nothing
+  bool discard_output{false};
+
+  // if set, waiting for the child spins first, as long as its "command
+  // template" usually runs (& the child gets recorded there once it exits); it
+  // must outlive the child
+  wait_tuner *wait_tuning{nullptr};
+};
+
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,75 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace exec_path_args::os_wrapper {
+
+// learns how long children of each "command template" usually run, so that
+// waiting for them (`exec_path_args::update_and_get_state` with a nonzero
+// timeout) can first spin - probing with `waitid(WNOHANG)` & pausing in
+// between - instead of going straight to sleep in `poll`; for children that
+// finish in well under a millisecond, the sleep/wakeup round trip would
+// otherwise dominate (see `spawn_options::wait_tuning`)
+// a template is the path & the arguments with any digits ignored (so e.g.
+// `sleep 0.1` & `sleep 0.2` are the same one); only children that exit (i.e.
+// aren't killed by a signal) are learned from
+// thread-safe
+struct wait_tuner {
+  using template_id = std::uint64_t;
+
+  // no spinning on a single CPU - the spinning parent would only compete with
+  // the very child it waits for
+  [[nodiscard]] static long long default_max_spin_ns();
+
+  // `max_spin_ns` ~ children usually running longer than this are never spun
+  // for; `max_templates` ~ any further templates are not learned
+  explicit wait_tuner(long long const max_spin_ns = default_max_spin_ns(),
+                      std::size_t const max_templates = 4096);
+
+  [[nodiscard]] static template_id
+  template_of(std::string const &path, std::vector<std::string> const &args);
+
+  // how long since its spawn a child may be spun for (`0` ~ don't)
+  [[nodiscard]] long long spin_budget_ns(template_id const id) const;
+
+  void record(template_id const id, long long const duration_ns);
+
+private:
+  wait_tuner(wait_tuner const &) = delete;
+  wait_tuner &operator=(wait_tuner const &) = delete;
+  wait_tuner(wait_tuner &&) = delete;
+  wait_tuner &operator=(wait_tuner &&) = delete;
+
+  long long const max_spin_ns;
+  std::size_t const max_templates;
+
+  mutable std::mutex mtx;
+  // exponentially weighted moving average of the recent durations
+  std::unordered_map<template_id, long long> typical_ns;
+};
+
+} // namespace exec_path_args::os_wrapper
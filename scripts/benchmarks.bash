@@ -0,0 +1,12 @@
+#!/usr/bin/env bash
+
+# assumes PWD being parent directory ... TODO polish later
+
+set -e
+
+scripts/build.bash \
+    --target exec_path_args_benchmarks \
+    --target some_cli_app
+
+build/tests/benchmarks/exec_path_args_benchmarks \
+    "$@"
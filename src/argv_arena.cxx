@@ -0,0 +1,66 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "impl/argv_arena.hxx"
+
+#include <cassert>
+#include <cstring>
+
+namespace exec_path_args::os_wrapper {
+
+std::size_t
+argv_arena::words_needed(std::string const &path,
+                         std::vector<std::string> const &args) noexcept {
+  std::size_t chars{path.size() + 1};
+  for (auto const &arg : args) {
+    chars += arg.size() + 1;
+  }
+  static auto constexpr word{sizeof(char *)};
+  return (args.size() + 2) + ((chars + word - 1) / word);
+}
+
+char **argv_arena::emplace(std::string const &path,
+                           std::vector<std::string> const &args) noexcept {
+  auto const words{words_needed(path, args)};
+  assert(used + words <= capacity);
+
+  char **const argv{storage.get() + used};
+  auto chars{reinterpret_cast<char *>(argv + args.size() + 2)};
+
+  static auto constexpr append = [](char *&dst, std::string const &str) {
+    std::memcpy(dst, str.c_str(), str.size() + 1);
+    auto const ret{dst};
+    dst += str.size() + 1;
+    return ret;
+  };
+
+  // https://man7.org/linux/man-pages/man3/exec.3.html -> "The first
+  // argument, by convention, should point to the filename associated with
+  // the file being executed"
+  argv[0] = append(chars, path);
+  for (std::size_t i{0}; i < args.size(); ++i) {
+    argv[i + 1] = append(chars, args[i]);
+  }
+  argv[args.size() + 1] = nullptr;
+
+  used += words;
+  return argv;
+}
+
+} // namespace exec_path_args::os_wrapper
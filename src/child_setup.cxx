@@ -0,0 +1,418 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "impl/child_setup.hxx"
+
+#include <fcntl.h>
+#include <linux/ioprio.h>
+#include <linux/mempolicy.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+#include "impl/syscall_helper.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+std::string describe(child_error const &err) {
+  static auto constexpr stage_name =
+      [](child_error::stage const stage) -> char const * {
+    switch (stage) {
+    case child_error::stage::redirect:
+      return "`dup2`";
+    case child_error::stage::fd_cleanup:
+      return "`close_range`";
+    case child_error::stage::cpu_affinity:
+      return "`sched_setaffinity`";
+    case child_error::stage::numa_policy:
+      return "`set_mempolicy`";
+    case child_error::stage::nice_value:
+      return "`setpriority`";
+    case child_error::stage::io_priority:
+      return "`ioprio_set`";
+    case child_error::stage::scheduling_policy:
+      return "`sched_setscheduler`";
+    case child_error::stage::resource_limit:
+      return "`setrlimit`";
+    case child_error::stage::exec:
+      return "`execv`";
+    default:
+      return "unknown stage";
+    }
+  };
+
+  std::string detail;
+  if (err.failed_stage == child_error::stage::redirect) {
+    detail = " (onto fd " + std::to_string(err.detail) + ")";
+  } else if (err.failed_stage == child_error::stage::resource_limit) {
+    detail = " (resource " + std::to_string(err.detail) + ")";
+  }
+
+  return std::string{stage_name(err.failed_stage)} + detail +
+         " failed - errno " + std::to_string(err.errno_val) + " ~ \"" +
+         std::strerror(err.errno_val) + "\"";
+}
+
+bool wait_for_exec(native_fd_t const error_pipe_out, child_error &err) {
+  ssize_t nbytes;
+  do {
+    nbytes = read(error_pipe_out, &err, sizeof(err));
+  } while ((nbytes == -1) && (current_errno() == EINTR));
+  EXEC_PATH_ARGS_SYSCALL_HELPER(nbytes);
+
+  // `sizeof(child_error) < PIPE_BUF` -> it's written atomically
+  return nbytes == static_cast<ssize_t>(sizeof(err));
+}
+
+child_setup::child_setup(spawn_options const &options)
+    : max_fd{static_cast<int>(sysconf(_SC_OPEN_MAX))} {
+  redirects.reserve(3 + options.extra_fds.size());
+  for (auto const &extra : options.extra_fds) {
+    if (extra.child_fd <= STDERR_FILENO) {
+      throw std::runtime_error{
+          "invalid spawn options - extra fds must be above stderr!"};
+    } else if ((extra.parent_fd != invalid_fd) && (extra.parent_fd < 0)) {
+      throw std::runtime_error{"invalid spawn options - invalid parent fd!"};
+    }
+    for (auto const &other : options.extra_fds) {
+      if ((&other != &extra) && (other.child_fd == extra.child_fd)) {
+        throw std::runtime_error{
+            "invalid spawn options - duplicate extra child fd!"};
+      }
+    }
+  }
+
+  if ((options.stdin_fd != invalid_fd) && (options.stdin_fd < 0)) {
+    throw std::runtime_error{"invalid spawn options - invalid stdin fd!"};
+  }
+
+  if ((options.stdin_pipe_capacity < 0) ||
+      (options.stdout_pipe_capacity < 0) ||
+      (options.stderr_pipe_capacity < 0)) {
+    throw std::runtime_error{
+        "invalid spawn options - negative pipe capacity!"};
+  }
+
+  if (!options.cpu_affinity.empty()) {
+    set_cpu_affinity = true;
+    CPU_ZERO(&cpus);
+    for (auto const cpu : options.cpu_affinity) {
+      if ((cpu < 0) || (CPU_SETSIZE <= cpu)) {
+        throw std::runtime_error{
+            "invalid spawn options - CPU index out of range!"};
+      }
+      CPU_SET(cpu, &cpus);
+    }
+  }
+
+  switch (options.numa_policy) {
+  case spawn_options::memory_policy::inherit:
+    break;
+  case spawn_options::memory_policy::local:
+    numa_mode = MPOL_LOCAL;
+    break;
+  case spawn_options::memory_policy::preferred:
+    numa_mode = MPOL_PREFERRED;
+    break;
+  case spawn_options::memory_policy::bind:
+    numa_mode = MPOL_BIND;
+    break;
+  case spawn_options::memory_policy::interleave:
+    numa_mode = MPOL_INTERLEAVE;
+    break;
+  default:
+    throw std::runtime_error{"invalid spawn options - unknown NUMA policy!"};
+  }
+  if ((numa_mode != -1) && (numa_mode != MPOL_LOCAL)) {
+    if (options.numa_nodes.empty()) {
+      throw std::runtime_error{
+          "invalid spawn options - NUMA policy requires some nodes!"};
+    }
+    numa_with_nodes = true;
+    for (auto const node : options.numa_nodes) {
+      if ((node < 0) || (max_numa_nodes <= node)) {
+        throw std::runtime_error{
+            "invalid spawn options - NUMA node out of range!"};
+      }
+      numa_nodes[node / bits_per_mask] |= 1UL << (node % bits_per_mask);
+    }
+  }
+
+  if (options.nice_value.has_value()) {
+    set_nice = true;
+    nice_value = *options.nice_value;
+  }
+
+  if (options.io_priority != spawn_options::io_priority_class::inherit) {
+    if ((options.io_priority_level < 0) ||
+        (IOPRIO_NR_LEVELS <= options.io_priority_level)) {
+      throw std::runtime_error{
+          "invalid spawn options - I/O priority level out of range!"};
+    }
+    switch (options.io_priority) {
+    case spawn_options::io_priority_class::realtime:
+      io_priority =
+          IOPRIO_PRIO_VALUE(IOPRIO_CLASS_RT, options.io_priority_level);
+      break;
+    case spawn_options::io_priority_class::best_effort:
+      io_priority =
+          IOPRIO_PRIO_VALUE(IOPRIO_CLASS_BE, options.io_priority_level);
+      break;
+    case spawn_options::io_priority_class::idle:
+      io_priority = IOPRIO_PRIO_VALUE(IOPRIO_CLASS_IDLE, 0);
+      break;
+    default:
+      throw std::runtime_error{
+          "invalid spawn options - unknown I/O priority class!"};
+    }
+  }
+
+  switch (options.scheduling) {
+  case spawn_options::scheduling_policy::inherit:
+    break;
+  case spawn_options::scheduling_policy::other:
+    scheduling_policy = SCHED_OTHER;
+    break;
+  case spawn_options::scheduling_policy::batch:
+    scheduling_policy = SCHED_BATCH;
+    break;
+  case spawn_options::scheduling_policy::idle:
+    scheduling_policy = SCHED_IDLE;
+    break;
+  default:
+    throw std::runtime_error{
+        "invalid spawn options - unknown scheduling policy!"};
+  }
+
+  if (static_cast<std::size_t>(RLIM_NLIMITS) <
+      options.resource_limits.size()) {
+    throw std::runtime_error{"invalid spawn options - too many rlimits!"};
+  }
+  for (auto const &limit : options.resource_limits) {
+    if ((limit.resource < 0) || (RLIM_NLIMITS <= limit.resource)) {
+      throw std::runtime_error{"invalid spawn options - unknown rlimit!"};
+    } else if (limit.hard < limit.soft) {
+      throw std::runtime_error{
+          "invalid spawn options - soft rlimit exceeds the hard one!"};
+    }
+    limit_resources[num_limits] = limit.resource;
+    limit_values[num_limits] = rlimit{limit.soft, limit.hard};
+    ++num_limits;
+  }
+
+  if (!options.environment.empty()) {
+    static auto constexpr name_of = [](std::string_view const entry) {
+      return entry.substr(0, entry.find('='));
+    };
+
+    std::size_t total_size{0};
+    for (auto const &entry : options.environment) {
+      if (entry.find('=') == std::string::npos) {
+        throw std::runtime_error{
+            "invalid spawn options - environment entry without `=`!"};
+      }
+      total_size += entry.size() + 1;
+    }
+    env_strings = std::make_unique<char[]>(total_size);
+
+    for (char **inherited{environ}; *inherited != nullptr; ++inherited) {
+      auto const name{name_of(*inherited)};
+      if (std::none_of(options.environment.begin(), options.environment.end(),
+                       [name](std::string const &entry) {
+                         return name_of(entry) == name;
+                       })) {
+        envp.push_back(*inherited);
+      }
+    }
+    char *p{env_strings.get()};
+    for (auto const &entry : options.environment) {
+      std::memcpy(p, entry.c_str(), entry.size() + 1);
+      envp.push_back(p);
+      p += entry.size() + 1;
+    }
+    envp.push_back(nullptr);
+  }
+}
+
+void child_setup::redirect(native_fd_t const source, int const target) {
+  auto it{redirects.begin()};
+  while ((it != redirects.end()) && (it->target < target)) {
+    ++it;
+  }
+  redirects.insert(it, fd_redirect{source, target});
+}
+
+void child_setup::run(char *const argv[]) noexcept {
+  redirect_fds();
+
+  if (set_cpu_affinity && (sched_setaffinity(0, sizeof(cpus), &cpus) == -1)) {
+    report_and_exit(child_error::stage::cpu_affinity, errno);
+  }
+
+  if (numa_mode != -1) {
+    // "+ 1" due to the kernel ignoring the last bit ... see the `BUGS` section
+    // of the man page
+    if (syscall(static_cast<long>(SYS_set_mempolicy), numa_mode,
+                numa_with_nodes ? numa_nodes : nullptr,
+                numa_with_nodes ? max_numa_nodes + 1 : 0) == -1) {
+      report_and_exit(child_error::stage::numa_policy, errno);
+    }
+  }
+
+  if (set_nice && (setpriority(PRIO_PROCESS, 0, nice_value) == -1)) {
+    report_and_exit(child_error::stage::nice_value, errno);
+  }
+
+  // glibc provides no wrapper for this one:
+  if ((io_priority != -1) &&
+      (syscall(static_cast<long>(SYS_ioprio_set), IOPRIO_WHO_PROCESS, 0,
+               io_priority) == -1)) {
+    report_and_exit(child_error::stage::io_priority, errno);
+  }
+
+  if (scheduling_policy != -1) {
+    sched_param const param{}; // must be `0` for these non-realtime policies
+    if (sched_setscheduler(0, scheduling_policy, &param) == -1) {
+      report_and_exit(child_error::stage::scheduling_policy, errno);
+    }
+  }
+
+  // last, so e.g. `RLIMIT_NOFILE` doesn't interfere with the steps above
+  for (int i{0}; i < num_limits; ++i) {
+    if (setrlimit(static_cast<__rlimit_resource_t>(limit_resources[i]),
+                  &limit_values[i]) == -1) {
+      report_and_exit(child_error::stage::resource_limit, errno,
+                      limit_resources[i]);
+    }
+  }
+
+  // Execute the command
+  if (envp.empty()) {
+    execv(argv[0], argv);
+  } else {
+    execve(argv[0], argv, envp.data());
+  }
+  report_and_exit(child_error::stage::exec, errno);
+}
+
+void child_setup::redirect_fds() noexcept {
+  if (redirects.empty()) {
+    return;
+  }
+
+  // first move every source (and the "exec error" pipe) above all targets, so
+  // no `dup2` below can overwrite a source that is still needed; these copies
+  // are `O_CLOEXEC` -> they don't survive `execv`
+  int const lowest_safe_fd{redirects.back().target + 1};
+  auto const move_above_targets = [lowest_safe_fd](native_fd_t &fd) {
+    if (fd < lowest_safe_fd) {
+      fd = fcntl(fd, F_DUPFD_CLOEXEC, lowest_safe_fd);
+    }
+    return fd != -1;
+  };
+
+  if (!move_above_targets(error_fd)) {
+    // can't even report it ...
+    std::_Exit(EXIT_FAILURE);
+  }
+  for (auto &r : redirects) {
+    if (!move_above_targets(r.source)) {
+      report_and_exit(child_error::stage::redirect, errno, r.target);
+    }
+  }
+
+  // (`dup2`ed fds don't have `FD_CLOEXEC` set)
+  for (auto const &r : redirects) {
+    if (dup2(r.source, r.target) == -1) {
+      report_and_exit(child_error::stage::redirect, errno, r.target);
+    }
+  }
+
+  // everything else above stderr gets `FD_CLOEXEC`, so the parent's fds (e.g.
+  // its sockets, other children's pipes, ...) don't leak into the child; see
+  // https://man7.org/linux/man-pages/man2/close_range.2.html
+  auto const cloexec_range = [this](unsigned const first,
+                                    unsigned const last) -> bool {
+    if (last < first) {
+      return true;
+    }
+    if (close_range(first, last, CLOSE_RANGE_CLOEXEC) == 0) {
+      return true;
+    } else if ((errno != ENOSYS) && (errno != EINVAL)) {
+      return false;
+    }
+    // older kernel - do it one by one (slow, but correct)
+    auto const actual_last{std::min(last, static_cast<unsigned>(max_fd))};
+    for (auto fd{first}; fd <= actual_last; ++fd) {
+      fcntl(static_cast<int>(fd), F_SETFD, FD_CLOEXEC);
+    }
+    return true;
+  };
+
+  unsigned first{STDERR_FILENO + 1};
+  for (auto const &r : redirects) {
+    auto const target{static_cast<unsigned>(r.target)};
+    if (first <= target) {
+      if (!cloexec_range(first, target - 1)) {
+        report_and_exit(child_error::stage::fd_cleanup, errno);
+      }
+      first = target + 1;
+    }
+  }
+  if (!cloexec_range(first, ~0U)) {
+    report_and_exit(child_error::stage::fd_cleanup, errno);
+  }
+}
+
+void child_setup::report_and_exit(child_error::stage const stage,
+                                  int const errno_val,
+                                  int const detail) const noexcept {
+  child_error const err{stage, errno_val, detail};
+  while ((write(error_fd, &err, sizeof(err)) == -1) && (errno == EINTR)) {
+  }
+
+  // Comment under <https://youtu.be/ki9omnMeYS8?si=WIVsmwHjcDxvwvlI> states:
+  /*
+  @keithmiller4358
+  It's also worth mentioning that if you exit from signal handlers or after
+  fork(), but before exec*(), you should use _exit() from posix, or std::_Exit()
+  from c++11.  Anything called in such contexts must be async signal safe, and
+  shouldn't malloc or free memory, or do anything else that isn't async signal
+  safe. At least glibc has mutexes that can be left in inconsistent states in
+  such contexts, causing hangs. This precludes using buffered i/o in signal
+  handlers. This isn't an imaginary problem. I have fixed real cases of this in
+  breakpad integration, threaded code that drops privelege by forking etc.
+  Unless you like fixing weird hangs on internal glibc functions that occur
+  randomly and rarely, burn this into your memory.
+  */
+  // made me rethink & rework it so ...
+  // <https://en.cppreference.com/w/cpp/utility/program/_Exit> vs.
+  // <https://en.cppreference.com/w/cpp/utility/program/exit.html>
+  std::_Exit(EXIT_FAILURE);
+}
+
+} // namespace exec_path_args::os_wrapper
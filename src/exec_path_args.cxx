@@ -19,6 +19,7 @@
 
 #include "exec_path_args/exec_path_args.hxx"
 
+#include <fcntl.h>
 #include <sys/ioctl.h>
 #include <sys/poll.h>
 #include <sys/syscall.h>
@@ -31,45 +32,43 @@
 #include <csignal>
 #include <cstring>
 
-#include <exception>
-#include <iostream>
+#include <algorithm>
 #include <stdexcept>
 #include <utility>
 
+#include "exec_path_args/wait_tuner.hxx"
+
+#include "impl/argv_arena.hxx"
+#include "impl/child_setup.hxx"
+#include "impl/process_common.hxx"
+#include "impl/reaper.hxx"
 #include "impl/syscall_helper.hxx"
 
 namespace exec_path_args::os_wrapper {
 
-namespace {
-
-using timepoint_t = struct timespec;
-
-// copied from
-// <https://github.com/Ruzovej/cxxet/blob/main/include/public/cxxet/timepoint.hxx>
-// & simplified:
-[[nodiscard]] long long now_ns() {
-  // https://stackoverflow.com/a/42658433
-  // https://www.man7.org/linux/man-pages/man3/clock_gettime.3.html
-  timepoint_t t;
-  clock_gettime(CLOCK_MONOTONIC, &t);
-  return static_cast<long long>(t.tv_sec * 1'000'000'000 + t.tv_nsec);
-}
-
-} // namespace
+// it's paid for every tracked process (e.g. `std::vector<exec_path_args>` of
+// 100k ones) - so it shouldn't grow unnoticed (whatever is needed only until
+// it's spawned belongs to `spawn_inputs`, whatever only few need to
+// `rarely_used`)
+static_assert(sizeof(exec_path_args) <= 24 * sizeof(void *));
 
 void swap(exec_path_args &lhs, exec_path_args &rhs) noexcept {
   using std::swap;
 
-  swap(lhs.path, rhs.path);
-  swap(lhs.args, rhs.args);
+  swap(lhs.inputs, rhs.inputs);
   swap(lhs.time_spawned_ns, rhs.time_spawned_ns);
   swap(lhs.time_finished_ns, rhs.time_finished_ns);
   swap(lhs.handle, rhs.handle);
+  swap(lhs.pid_fd, rhs.pid_fd);
   swap(lhs.stdin_pipe, rhs.stdin_pipe);
   swap(lhs.stdout_pipe, rhs.stdout_pipe);
   swap(lhs.stderr_pipe, rhs.stderr_pipe);
   swap(lhs.current_state, rhs.current_state);
   swap(lhs.return_code, rhs.return_code);
+  swap(lhs.reason, rhs.reason);
+  swap(lhs.cpu_limited, rhs.cpu_limited);
+  swap(lhs.usage, rhs.usage);
+  swap(lhs.rare, rhs.rare);
   swap(lhs.stdout_buffer, rhs.stdout_buffer);
   swap(lhs.stdout_consumed_bytes, rhs.stdout_consumed_bytes);
   swap(lhs.stderr_buffer, rhs.stderr_buffer);
@@ -77,16 +76,18 @@ void swap(exec_path_args &lhs, exec_path_args &rhs) noexcept {
 }
 
 exec_path_args::exec_path_args(exec_path_args &&rhs) noexcept
-    : path{std::move(rhs.path)}, args{std::move(rhs.args)},
-      time_spawned_ns{rhs.time_spawned_ns},
+    : inputs{std::move(rhs.inputs)}, time_spawned_ns{rhs.time_spawned_ns},
       time_finished_ns{rhs.time_finished_ns}, handle{std::exchange(
                                                   rhs.handle,
                                                   invalid_process_handle)},
+      pid_fd{std::exchange(rhs.pid_fd, invalid_fd)},
       stdin_pipe{std::move(rhs.stdin_pipe)},
       stdout_pipe{std::move(rhs.stdout_pipe)}, stderr_pipe{std::move(
                                                    rhs.stderr_pipe)},
       current_state{std::exchange(rhs.current_state, state::uninitialzied)},
-      return_code{rhs.return_code}, stdout_buffer{std::move(rhs.stdout_buffer)},
+      return_code{rhs.return_code}, reason{rhs.reason},
+      cpu_limited{rhs.cpu_limited}, usage{rhs.usage},
+      rare{std::move(rhs.rare)}, stdout_buffer{std::move(rhs.stdout_buffer)},
       stdout_consumed_bytes{rhs.stdout_consumed_bytes}, stderr_buffer{std::move(
                                                             rhs.stderr_buffer)},
       stderr_consumed_bytes{rhs.stderr_consumed_bytes} {}
@@ -100,75 +101,33 @@ exec_path_args &exec_path_args::operator=(exec_path_args &&rhs) noexcept {
 }
 
 exec_path_args::~exec_path_args() noexcept {
-  if (manages_process()) {
-    do_kill(); // if this throws ... just let the OS "abort us".
-  }
-}
-
-namespace {
-
-struct my_cstr_arr_deleter {
-  void operator()(char *null_terminated_arr[]) const {
-    if (null_terminated_arr != nullptr) {
-      for (char **ptr = null_terminated_arr; *ptr != nullptr; ++ptr) {
-        std::free(*ptr); // due to `strndup`
-      }
-      delete[] null_terminated_arr;
+  if (manages_process() && (current_state == state::running)) {
+    if (pid_fd != invalid_fd) {
+      // don't wait for it here - the reaper takes it over:
+      kill(handle, SIGKILL);
+      reaper::adopt_or_reap(handle, std::exchange(pid_fd, invalid_fd));
+    } else {
+      do_kill(); // if this throws ... just let the OS "abort us".
     }
   }
-};
-
-[[nodiscard]] std::unique_ptr<char *[], my_cstr_arr_deleter>
-build_args_cstr(std::string const &path, std::vector<std::string> const &args) {
-  auto const num_args{args.size()};
-
-  std::unique_ptr<char *[], my_cstr_arr_deleter> args_cstr_arr {
-    new char *[num_args + 2], {}
-  };
-
-  // https://man7.org/linux/man-pages/man3/exec.3.html -> "The first
-  // argument, by convention, should point to the filename associated with
-  // the file being executed"
-  args_cstr_arr[0] = strndup(path.c_str(), path.size());
-  for (std::size_t i{0}; i < num_args; ++i) {
-    args_cstr_arr[i + 1] = strndup(args[i].c_str(), args[i].size());
-  }
-  args_cstr_arr[num_args + 1] = nullptr;
-
-  return args_cstr_arr;
+  close_fd(pid_fd);
 }
 
-} // namespace
-
 exec_path_args::states
 exec_path_args::update_and_get_state(int const timeout_until_it_finishes_ms) {
   auto const previous_state{current_state};
 
   switch (current_state) {
   case state::ready: {
-    stdin_pipe.init();
-    stdout_pipe.init();
-    stderr_pipe.init();
+    pending_spawn pending{inputs->options}; // validates them, hence first
+    prepare_spawn(pending);
 
     // it's safer to do as little after the `fork` and before `exec` as
     // possible:
-    auto const argv{build_args_cstr(path, args)};
-
-    auto const pid{EXEC_PATH_ARGS_SYSCALL_HELPER(fork())};
-    if (pid == 0) // Child process
-    {
-      exec_in_child(argv.get());
-    } // else ... parent process
-
-    stdin_pipe.close_out();
-    stdout_pipe.close_in();
-    stderr_pipe.close_in();
+    argv_arena arena{argv_arena::words_needed(inputs->path, inputs->args)};
+    launch(pending, arena.emplace(inputs->path, inputs->args));
 
-    time_spawned_ns = now_ns();
-    static_assert(
-        std::is_same_v<std::decay_t<decltype(pid)>, process_handle_t>);
-    handle = pid;
-    current_state = state::running;
+    complete_spawn(pending);
 
     if (timeout_until_it_finishes_ms != 0) {
       // IMHO safer than "fallthrough":
@@ -184,16 +143,33 @@ exec_path_args::update_and_get_state(int const timeout_until_it_finishes_ms) {
           "cannot update state - process handle is invalid!"};
     }
 
-    // https://man7.org/linux/man-pages/man2/pidfd_open.2.html
-    auto const pid_fd{EXEC_PATH_ARGS_SYSCALL_HELPER(static_cast<int>(
-        syscall(static_cast<long>(SYS_pidfd_open), handle, 0)))};
+    auto timeout_ms{timeout_until_it_finishes_ms};
+    if (auto *const tuner{this->tuner()};
+        (tuner != nullptr) && (timeout_ms != 0)) {
+      auto const start_ns{now_ns()};
+      auto spin_until_ns{time_spawned_ns +
+                         tuner->spin_budget_ns(rare->template_id)};
+      if (timeout_ms > 0) {
+        spin_until_ns =
+            std::min(spin_until_ns, start_ns + timeout_ms * 1'000'000LL);
+      }
+      if ((start_ns < spin_until_ns) && spin_until_finished(spin_until_ns)) {
+        break;
+      }
+      if (timeout_ms > 0) {
+        // (rounded up, so it doesn't become "don't block")
+        auto const spent_ms{(now_ns() - start_ns) / 1'000'000};
+        timeout_ms = static_cast<int>(
+            std::max<long long>(timeout_ms - spent_ms, 1));
+      }
+    }
 
     pollfd p_fd{pid_fd, POLLIN};
 
     // https://man7.org/linux/man-pages/man2/poll.2.html
     // https://stackoverflow.com/a/65003348/10712915
-    auto const poll_res{EXEC_PATH_ARGS_SYSCALL_HELPER(
-        poll(&p_fd, 1, timeout_until_it_finishes_ms))};
+    auto const poll_res{
+        EXEC_PATH_ARGS_SYSCALL_HELPER(poll(&p_fd, 1, timeout_ms))};
 
     if (poll_res == 1) {
       query_status(false);
@@ -227,7 +203,92 @@ exec_path_args::update_and_get_state(int const timeout_until_it_finishes_ms) {
   return {previous_state, current_state};
 }
 
+void exec_path_args::prepare_spawn(pending_spawn &pending) {
+  reset_pipes(); // e.g. after a previous failed attempt
+
+  prepare_child_fds(
+      pending, inputs->options, stdin_pipe, stdout_pipe, stderr_pipe,
+      [this](int const child_fd) -> pipe_helper & {
+        auto &captured{rare_state().extra_outputs.emplace_back()};
+        captured.child_fd = child_fd;
+        return captured.pipe;
+      });
+}
+
+void exec_path_args::launch(pending_spawn &pending, char *const argv[]) {
+  fork_child(pending, argv);
+
+  stdin_pipe.close_out();
+  stdout_pipe.close_in();
+  stderr_pipe.close_in();
+  if (rare) {
+    for (auto &captured : rare->extra_outputs) {
+      captured.pipe.close_in();
+    }
+  }
+}
+
+void exec_path_args::complete_spawn(pending_spawn &pending) {
+  try {
+    pid_fd = await_exec(pending);
+  } catch (...) {
+    reset_pipes();
+    throw;
+  }
+
+  time_spawned_ns = now_ns();
+  handle = pending.pid;
+  current_state = state::running;
+
+  // not needed anymore (besides whether `RLIMIT_CPU` applies, see
+  // `classify_exit`), so don't hold onto them for the child's whole life:
+  cpu_limited = inputs->options.limits(RLIMIT_CPU);
+  if (inputs->options.wait_tuning != nullptr) {
+    auto &r{rare_state()};
+    r.tuner = inputs->options.wait_tuning;
+    r.template_id = wait_tuner::template_of(inputs->path, inputs->args);
+  }
+  inputs.reset();
+}
+
+void exec_path_args::reset_pipes() noexcept {
+  stdin_pipe = pipe_helper{};
+  stdout_pipe = pipe_helper{};
+  stderr_pipe = pipe_helper{};
+  if (rare) {
+    rare->extra_outputs.clear();
+  }
+}
+
+exec_path_args::rarely_used &exec_path_args::rare_state() {
+  if (!rare) {
+    rare = std::make_unique<rarely_used>();
+  }
+  return *rare;
+}
+
 void exec_path_args::send_to_stdin(std::string_view const data) {
+  send_to_stdin(&data, 1);
+}
+
+void exec_path_args::send_to_stdin(std::string_view const *const pieces,
+                                   std::size_t const count) {
+  check_stdin();
+  static_cast<void>(write_pieces(stdin_pipe.get_in(), pieces, count, true));
+}
+
+std::size_t exec_path_args::try_send_to_stdin(std::string_view const data) {
+  return try_send_to_stdin(&data, 1);
+}
+
+std::size_t
+exec_path_args::try_send_to_stdin(std::string_view const *const pieces,
+                                  std::size_t const count) {
+  check_stdin();
+  return write_pieces(stdin_pipe.get_in(), pieces, count, false);
+}
+
+void exec_path_args::check_stdin() const {
   if (!manages_process()) {
     throw std::runtime_error{
         "cannot write to inferior stdin - process handle is invalid!"};
@@ -238,17 +299,6 @@ void exec_path_args::send_to_stdin(std::string_view const data) {
     throw std::runtime_error{
         "cannot write to inferior stdin - process isn't running!"};
   }
-
-  ssize_t written{0};
-  auto const data_size{static_cast<ssize_t>(
-      data.size())}; // over-simplified version ... since
-                     // `std::ssize` for `std::string_view` is C++20
-
-  while (written < data_size) {
-    auto const now_written{EXEC_PATH_ARGS_SYSCALL_HELPER(write(
-        stdin_pipe.get_in(), data.data() + written, data_size - written))};
-    written += now_written;
-  }
 }
 
 void exec_path_args::close_stdin() {
@@ -298,10 +348,101 @@ std::string exec_path_args::get_stderr() {
   return std::move(stderr_buffer);
 }
 
+std::string_view exec_path_args::read_extra_output(int const child_fd,
+                                                   bool const whole) {
+  auto &extra{update_extra_buffer(child_fd)};
+  return get_buffer(extra.buffer, extra.consumed_bytes, whole);
+}
+
+std::string exec_path_args::get_extra_output(int const child_fd) {
+  return std::move(update_extra_buffer(child_fd).buffer);
+}
+
+namespace {
+
+void read_pipe(native_fd_t const fd, std::string &buffer) {
+  if (fd == invalid_fd) {
+    throw std::runtime_error{
+        "cannot read from given pipe - it's closed or not initialized!"};
+  }
+
+  auto const buf_prev_size{static_cast<ssize_t>(buffer.size())};
+
+  int avail{0};
+  EXEC_PATH_ARGS_SYSCALL_HELPER(ioctl(fd, FIONREAD, &avail));
+
+  ssize_t nbytes{0};
+  if (0 < avail) // TODO read in a loop (in case `nbytes` < `avail`)?!
+  {
+    buffer.resize(static_cast<size_t>(buf_prev_size + avail));
+
+    //#if defined(__clang__)
+    //      // TODO get rid of the ugly `const_cast`
+    //      nbytes = EXEC_PATH_ARGS_SYSCALL_HELPER(
+    //          read(fd, const_cast<char *>(buffer.data()) + buf_prev_size,
+    //          avail));
+    //#else
+    nbytes = EXEC_PATH_ARGS_SYSCALL_HELPER(
+        read(fd, buffer.data() + buf_prev_size, avail));
+    //#endif
+  }
+  if (nbytes < avail) {
+    throw std::runtime_error(
+        "failed to read all available bytes from given pipe!");
+  }
+}
+
+} // namespace
+
+void exec_path_args::shrink_to_fit() {
+  if (current_state != state::finished) {
+    throw std::runtime_error{"cannot shrink - process isn't finished!"};
+  }
+
+  stdin_pipe = pipe_helper{}; // nobody reads it anymore
+  update_buffer(true);
+  update_buffer(false);
+  stdout_pipe = pipe_helper{};
+  stderr_pipe = pipe_helper{};
+  stdout_buffer.shrink_to_fit();
+  stderr_buffer.shrink_to_fit();
+
+  if (!rare) {
+    return;
+  }
+  rare->tuner = nullptr; // (used only while it runs)
+  for (auto &extra : rare->extra_outputs) {
+    if (extra.pipe.get_out() != invalid_fd) {
+      read_pipe(extra.pipe.get_out(), extra.buffer);
+    }
+    extra.pipe = pipe_helper{};
+    extra.buffer.shrink_to_fit();
+  }
+  if (rare->extra_outputs.empty()) {
+    rare.reset();
+  } else {
+    rare->extra_outputs.shrink_to_fit();
+  }
+}
+
 void exec_path_args::do_kill() {
+  if (send_kill()) {
+    reap_killed();
+  }
+}
+
+bool exec_path_args::send_kill() {
   if (manages_process() && (current_state == state::running)) {
     EXEC_PATH_ARGS_SYSCALL_HELPER(kill(handle, SIGKILL));
-    query_status(true);
+    return true;
+  }
+  return false;
+}
+
+void exec_path_args::reap_killed() {
+  query_status(true);
+  if ((reason != exit_reason::exited) && (return_code == SIGKILL)) {
+    reason = exit_reason::killed;
   }
 }
 
@@ -334,43 +475,26 @@ int exec_path_args::get_return_code() const {
   return return_code;
 }
 
-void exec_path_args::exec_in_child(char *args[]) {
-  try {
-    stdin_pipe.close_in();
-    EXEC_PATH_ARGS_SYSCALL_HELPER(dup2(stdin_pipe.get_out(), STDIN_FILENO));
-
-    stdout_pipe.close_out();
-    EXEC_PATH_ARGS_SYSCALL_HELPER(dup2(stdout_pipe.get_in(), STDOUT_FILENO));
-
-    stderr_pipe.close_out();
-    EXEC_PATH_ARGS_SYSCALL_HELPER(dup2(stderr_pipe.get_in(), STDERR_FILENO));
-
-    // Execute the command
-    EXEC_PATH_ARGS_SYSCALL_HELPER(execv(args[0], args));
-  } catch (std::exception const &e) {
-    // TODO is it safe to use `std::cerr` here (e.g. after `fork`, etc.)?
-    std::cerr << "child process failed - caught exception: " << e.what()
-              << '\n';
-  }
-
-  // Comment under <https://youtu.be/ki9omnMeYS8?si=WIVsmwHjcDxvwvlI> states:
-  /*
-  @keithmiller4358
-  It's also worth mentioning that if you exit from signal handlers or after
-  fork(), but before exec*(), you should use _exit() from posix, or std::_Exit()
-  from c++11.  Anything called in such contexts must be async signal safe, and
-  shouldn't malloc or free memory, or do anything else that isn't async signal
-  safe. At least glibc has mutexes that can be left in inconsistent states in
-  such contexts, causing hangs. This precludes using buffered i/o in signal
-  handlers. This isn't an imaginary problem. I have fixed real cases of this in
-  breakpad integration, threaded code that drops privelege by forking etc.
-  Unless you like fixing weird hangs on internal glibc functions that occur
-  randomly and rarely, burn this into your memory.
-  */
-  // made me rethink & rework it so ...
-  // <https://en.cppreference.com/w/cpp/utility/program/_Exit> vs.
-  // <https://en.cppreference.com/w/cpp/utility/program/exit.html>
-  std::_Exit(EXIT_FAILURE);
+exec_path_args::resource_usage exec_path_args::get_resource_usage() const {
+  if (!manages_process()) {
+    throw std::runtime_error{
+        "can't obtain resource usage - process handle is invalid!"};
+  } else if (current_state != state::finished) {
+    throw std::runtime_error{
+        "can't obtain resource usage - process isn't finished!"};
+  }
+  return usage;
+}
+
+exec_path_args::exit_reason exec_path_args::get_exit_reason() const {
+  if (!manages_process()) {
+    throw std::runtime_error{
+        "can't obtain exit reason - process handle is invalid!"};
+  } else if (current_state != state::finished) {
+    throw std::runtime_error{
+        "can't obtain exit reason - process isn't finished!"};
+  }
+  return reason;
 }
 
 void exec_path_args::query_status(bool const wait_for_finishing) {
@@ -378,9 +502,14 @@ void exec_path_args::query_status(bool const wait_for_finishing) {
     throw std::runtime_error{"can't query status - process handle is invalid!"};
   } else if (current_state == state::running) {
     siginfo_t status{};
+    rusage ru{};
     int const options{WEXITED | (wait_for_finishing ? 0 : WNOHANG)};
     // https://man7.org/linux/man-pages/man2/wait.2.html
-    EXEC_PATH_ARGS_SYSCALL_HELPER(waitid(P_PID, handle, &status, options));
+    // (the raw syscall takes a 5th argument, filled with the child's usage -
+    // cheaper & more precise than diffing `getrusage(RUSAGE_CHILDREN)`)
+    EXEC_PATH_ARGS_SYSCALL_HELPER(
+        syscall(static_cast<long>(SYS_waitid), P_PID, handle, &status, options,
+                &ru));
 
     if ((status.si_pid != 0) &&
         ((status.si_code == CLD_EXITED) || (status.si_code == CLD_KILLED) ||
@@ -391,8 +520,15 @@ void exec_path_args::query_status(bool const wait_for_finishing) {
       }
       time_finished_ns = now_ns();
       current_state = state::finished;
+      close_fd(pid_fd); // not needed anymore
       return_code =
           status.si_status; // or signal ... don't make a difference here
+      reason = classify_exit(status, cpu_limited);
+      usage = to_resource_usage(ru);
+      if (auto *const tuner{this->tuner()};
+          (tuner != nullptr) && (reason == exit_reason::exited)) {
+        tuner->record(rare->template_id, time_finished_ns - time_spawned_ns);
+      }
     }
   } else if (current_state == state::finished) {
     return;
@@ -402,47 +538,60 @@ void exec_path_args::query_status(bool const wait_for_finishing) {
   }
 }
 
+bool exec_path_args::spin_until_finished(long long const until_ns) {
+  // exponential back-off between the probes, bounded so a child finishing
+  // meanwhile isn't noticed much later
+  static int constexpr max_pauses{64};
+
+  int pauses{1};
+  do {
+    query_status(false);
+    if (current_state == state::finished) {
+      return true;
+    }
+    for (int k{0}; k < pauses; ++k) {
+      cpu_relax();
+    }
+    pauses = std::min(2 * pauses, max_pauses);
+  } while (now_ns() < until_ns);
+  return false;
+}
+
 void exec_path_args::update_buffer(bool const for_stdout) {
   if (!manages_process()) {
     throw std::runtime_error{
         "cannot update any buffer - process handle is invalid!"};
   }
 
-  static auto constexpr read_pipe = [](native_fd_t const fd,
-                                       std::string &buffer) {
-    if (fd == invalid_fd) {
-      throw std::runtime_error{
-          "cannot read from given pipe - it's closed or not initialized!"};
-    }
+  auto const fd{for_stdout ? stdout_pipe.get_out() : stderr_pipe.get_out()};
+  if (fd == invalid_fd) {
+    // already drained & closed by `shrink_to_fit`, or never created (see
+    // `spawn_options::discard_output`)
+    return;
+  }
+  read_pipe(fd, for_stdout ? stdout_buffer : stderr_buffer);
+}
 
-    auto const buf_prev_size{static_cast<ssize_t>(buffer.size())};
-
-    int avail{0};
-    EXEC_PATH_ARGS_SYSCALL_HELPER(ioctl(fd, FIONREAD, &avail));
-
-    ssize_t nbytes{0};
-    if (0 < avail) // TODO read in a loop (in case `nbytes` < `avail`)?!
-    {
-      buffer.resize(static_cast<size_t>(buf_prev_size + avail));
-
-      //#if defined(__clang__)
-      //      // TODO get rid of the ugly `const_cast`
-      //      nbytes = EXEC_PATH_ARGS_SYSCALL_HELPER(
-      //          read(fd, const_cast<char *>(buffer.data()) + buf_prev_size,
-      //          avail));
-      //#else
-      nbytes = EXEC_PATH_ARGS_SYSCALL_HELPER(
-          read(fd, buffer.data() + buf_prev_size, avail));
-      //#endif
-    }
-    if (nbytes < avail) {
-      throw std::runtime_error(
-          "failed to read all available bytes from given pipe!");
-    }
-  };
+exec_path_args::captured_output &
+exec_path_args::update_extra_buffer(int const child_fd) {
+  if (!manages_process()) {
+    throw std::runtime_error{
+        "cannot update any buffer - process handle is invalid!"};
+  }
 
-  read_pipe(for_stdout ? stdout_pipe.get_out() : stderr_pipe.get_out(),
-            for_stdout ? stdout_buffer : stderr_buffer);
+  if (rare) {
+    for (auto &extra : rare->extra_outputs) {
+      if (extra.child_fd == child_fd) {
+        if ((extra.pipe.get_out() != invalid_fd) ||
+            (current_state != state::finished)) {
+          read_pipe(extra.pipe.get_out(), extra.buffer);
+        }
+        return extra;
+      }
+    }
+  }
+  throw std::runtime_error{
+      "cannot update buffer - given fd isn't captured from the child!"};
 }
 
 } // namespace exec_path_args::os_wrapper
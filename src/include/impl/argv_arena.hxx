@@ -0,0 +1,50 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace exec_path_args::os_wrapper {
+
+// `argv`s (null-terminated arrays of pointers & the null-terminated strings
+// they point to) laid out in a single allocation - one or many of them
+struct argv_arena {
+  // number of `char *`-sized words one `argv` occupies
+  [[nodiscard]] static std::size_t
+  words_needed(std::string const &path,
+               std::vector<std::string> const &args) noexcept;
+
+  explicit argv_arena(std::size_t const total_words)
+      : storage{new char *[total_words]}, capacity{total_words} {}
+
+  // its `words_needed` must fit into the remaining capacity
+  [[nodiscard]] char **emplace(std::string const &path,
+                               std::vector<std::string> const &args) noexcept;
+
+private:
+  std::unique_ptr<char *[]> storage;
+  std::size_t capacity;
+  std::size_t used{0};
+};
+
+} // namespace exec_path_args::os_wrapper
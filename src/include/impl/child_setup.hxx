@@ -0,0 +1,136 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <sched.h>
+#include <sys/resource.h>
+
+#include <climits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "exec_path_args/native_fd_t.hxx"
+#include "exec_path_args/pipe_helper.hxx"
+#include "exec_path_args/process_handle_t.hxx"
+#include "exec_path_args/spawn_options.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+// sent by the child through the "exec error" pipe (`O_CLOEXEC`, so successful
+// `execv` closes it & parent reads EOF) in case anything before `execv` (or
+// `execv` itself) fails
+struct child_error {
+  enum class stage : int {
+    redirect,
+    fd_cleanup,
+    cpu_affinity,
+    numa_policy,
+    nice_value,
+    io_priority,
+    scheduling_policy,
+    resource_limit,
+    exec
+  };
+
+  stage failed_stage;
+  int errno_val;
+  int detail; // e.g. which resource limit or fd failed
+};
+
+[[nodiscard]] std::string describe(child_error const &err);
+
+// blocks until the child either `execv`s (returns `false`) or reports an error
+// (returns `true` & fills `err`)
+[[nodiscard]] bool wait_for_exec(native_fd_t const error_pipe_out,
+                                 child_error &err);
+
+// everything the child needs is prepared here by the parent, before `fork` - so
+// the child itself does only async-signal-safe syscalls (no allocations, no
+// exceptions, no locks, ...)
+struct child_setup {
+  // throws `std::runtime_error` on invalid `options`
+  explicit child_setup(spawn_options const &options);
+
+  // `source` (parent's fd) becomes `target` in the child; any other fd (besides
+  // stdin, stdout & stderr) is closed on `execv`
+  void redirect(native_fd_t const source, int const target);
+
+  // write end of the "exec error" pipe
+  native_fd_t error_fd{invalid_fd};
+
+  [[noreturn]] void run(char *const argv[]) noexcept;
+
+private:
+  struct fd_redirect {
+    native_fd_t source;
+    int target;
+  };
+
+  // sorted by `target`
+  std::vector<fd_redirect> redirects;
+  // only for kernels without `close_range` (< 5.9)
+  int max_fd{0};
+
+  void redirect_fds() noexcept;
+
+  static int constexpr max_numa_nodes{1024};
+  static int constexpr bits_per_mask{sizeof(unsigned long) * CHAR_BIT};
+
+  [[noreturn]] void report_and_exit(child_error::stage const stage,
+                                    int const errno_val,
+                                    int const detail = 0) const noexcept;
+
+  bool set_cpu_affinity{false};
+  cpu_set_t cpus{};
+
+  int numa_mode{-1}; // -1 ~ don't touch it
+  bool numa_with_nodes{false};
+  unsigned long numa_nodes[max_numa_nodes / bits_per_mask]{};
+
+  bool set_nice{false};
+  int nice_value{0};
+
+  int io_priority{-1}; // -1 ~ don't touch it
+
+  int scheduling_policy{-1}; // -1 ~ don't touch it
+
+  int num_limits{0};
+  int limit_resources[RLIM_NLIMITS]{};
+  rlimit limit_values[RLIM_NLIMITS]{};
+
+  // empty ~ inherited as is; otherwise the parent's `environ` entries (not
+  // overridden) followed by `env_strings`, `nullptr` terminated
+  std::unique_ptr<char[]> env_strings;
+  std::vector<char *> envp;
+};
+
+// a spawn "in flight" - from the parent preparing everything, until the child
+// successfully `execv`s (see `exec_path_args::prepare_spawn` & co.)
+struct pending_spawn {
+  // throws `std::runtime_error` on invalid `options`
+  explicit pending_spawn(spawn_options const &options) : setup{options} {}
+
+  child_setup setup;
+  pipe_helper exec_error_pipe;
+  process_handle_t pid{invalid_process_handle};
+};
+
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,110 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <signal.h>
+#include <sys/resource.h>
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+#include "exec_path_args/exec_path_args.hxx"
+#include "exec_path_args/pipe_helper.hxx"
+#include "exec_path_args/spawn_options.hxx"
+
+#include "impl/child_setup.hxx"
+
+// shared by `exec_path_args` & `process_group`
+namespace exec_path_args::os_wrapper {
+
+[[nodiscard]] long long now_ns() noexcept;
+
+// a hint for the CPU that this is a spin-wait loop (saves power & the sibling
+// hyper-thread's resources)
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+// (re)creates `p`, with the given capacity (if any)
+void acquire_pipe(pipe_helper &p, int const capacity = 0);
+
+// sets `pending` up to redirect the child's stdin, stdout, stderr &
+// `extra_fds` as `options` say, acquiring the pipes needed: `in`, `out` & `err`
+// (left alone for `stdin_fd` & `discard_output`), the one `capture` returns
+// for each captured extra fd, and the one reporting failures before/during
+// `execv`
+void prepare_child_fds(
+    pending_spawn &pending, spawn_options const &options, pipe_helper &in,
+    pipe_helper &out, pipe_helper &err,
+    std::function<pipe_helper &(int const child_fd)> const &capture);
+
+// `fork`s a child running `pending.setup` (sets `pending.pid`); the parent's
+// copy of the "exec error" pipe's write end is closed then, the other pipes'
+// child ends are left to the caller
+void fork_child(pending_spawn &pending, char *const argv[]);
+
+// blocks until the child of `pending` `execv`s & returns its pidfd; if that
+// fails (or the pidfd can't be opened), the child is reaped & it throws
+// `std::runtime_error`
+[[nodiscard]] native_fd_t await_exec(pending_spawn &pending);
+
+// writes `pieces` (one after another, as if concatenated) into the
+// non-blocking `fd` - in as few `writev`s as possible; `block` -> all of them
+// (`poll`ing whenever it's full), otherwise only what fits right now; returns
+// how many bytes that was; throws `std::runtime_error` on failure - except for
+// the reader being gone (`EPIPE`), if `reader_gone` is given (it's set then)
+std::size_t write_pieces(native_fd_t const fd,
+                         std::string_view const *const pieces,
+                         std::size_t const count, bool const block,
+                         bool *const reader_gone = nullptr);
+
+// `SIGPIPE` blocked for the calling thread while it lives - so writing into a
+// pipe nobody reads anymore only fails with `EPIPE`, instead of killing the
+// whole process; any `SIGPIPE` raised meanwhile is discarded
+// https://man7.org/linux/man-pages/man7/signal.7.html
+struct sigpipe_guard {
+  sigpipe_guard() noexcept;
+  ~sigpipe_guard() noexcept;
+
+private:
+  sigpipe_guard(sigpipe_guard const &) = delete;
+  sigpipe_guard &operator=(sigpipe_guard const &) = delete;
+
+  sigset_t previous_mask;
+  bool was_pending; // (someone else's - left alone)
+};
+
+// opened (write-only) on the first call & kept for the whole process
+[[nodiscard]] native_fd_t dev_null();
+
+[[nodiscard]] exec_path_args::resource_usage
+to_resource_usage(rusage const &ru) noexcept;
+
+// `status` as filled by `waitid`, for a terminated child; `cpu_limited` ~ its
+// `spawn_options::resource_limits` contained `RLIMIT_CPU`
+[[nodiscard]] exec_path_args::exit_reason
+classify_exit(siginfo_t const &status, bool const cpu_limited) noexcept;
+
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,66 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "exec_path_args/native_fd_t.hxx"
+#include "exec_path_args/process_handle_t.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+// takes ownership of children nobody waits for anymore (e.g. running ones whose
+// `exec_path_args` got destroyed) & reaps them once they terminate - on its own
+// thread (`epoll` over their pidfds), so nobody else blocks in `waitid`
+// process-wide, started lazily & never destroyed (so it's usable until the
+// very end, e.g. from static destructors); whatever is left unreaped on exit
+// gets reparented & reaped by `init`
+struct reaper {
+  // throws `std::runtime_error` if it can't be started (only the first call)
+  [[nodiscard]] static reaper &instance();
+
+  // `pid_fd` ~ https://man7.org/linux/man-pages/man2/pidfd_open.2.html of
+  // `pid`; ownership of both is taken over (in any case, even on failure - then
+  // it's reaped right away, blocking)
+  void adopt(process_handle_t const pid, native_fd_t pid_fd) noexcept;
+
+  // `instance().adopt(...)` for destructors - if the reaper can't be started,
+  // the (already signaled) child is reaped right away, blocking, instead of
+  // throwing
+  static void adopt_or_reap(process_handle_t const pid,
+                            native_fd_t pid_fd) noexcept;
+
+  // how many adopted children weren't reaped yet
+  [[nodiscard]] std::size_t pending() const noexcept {
+    return num_pending.load(std::memory_order_relaxed);
+  }
+
+private:
+  reaper();
+  ~reaper() = delete;
+
+  [[noreturn]] void run() noexcept;
+
+  native_fd_t epoll_fd{invalid_fd};
+  std::atomic<std::size_t> num_pending{0};
+};
+
+} // namespace exec_path_args::os_wrapper
@@ -21,10 +21,16 @@
 
 #include <string_view>
 
+#include "exec_path_args/native_fd_t.hxx"
+
 namespace exec_path_args::os_wrapper {
 
 [[nodiscard]] int current_errno() noexcept;
 
+// closes `fd` (if valid) & invalidates it; failures are only reported to
+// `std::cerr`
+void close_fd(native_fd_t &fd) noexcept;
+
 // returns: if successful (e.g. `0 <= syscall_ret`);
 // throws: `std::runtime_error` on failure with detailed message
 void check_syscall_ret_val(std::string_view const file, int const line,
@@ -0,0 +1,119 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace exec_path_args::os_wrapper {
+
+// hierarchical timing wheel (see e.g.
+// http://www.cs.columbia.edu/~nahum/w6998/papers/sosp87-timing-wheels.pdf) -
+// `levels` wheels of `slots_per_level` slots each, every slot holding an
+// intrusive (index based) doubly-linked list of timers; `arm` & `cancel` are
+// O(1), `advance` is O(1) per expired (or cascaded) timer & skips empty
+// stretches of time
+// timers are identified by dense, caller chosen ids (e.g. derived from an index
+// of a child); time is in abstract "ticks" (e.g. milliseconds), never going
+// backwards
+struct timer_wheel {
+  using timer_id = std::uint32_t;
+  using tick_t = long long;
+
+  timer_wheel() noexcept;
+
+  [[nodiscard]] tick_t now() const noexcept { return current; }
+  [[nodiscard]] std::size_t size() const noexcept { return num_armed; }
+  [[nodiscard]] bool armed(timer_id const id) const noexcept {
+    return (id < expiries.size()) && (slot_of[id] != nil);
+  }
+
+  // (re-)arms `id` to expire at `expiry` (at least one tick from `now()`)
+  void arm(timer_id const id, tick_t expiry);
+  // no-op if not armed
+  void cancel(timer_id const id) noexcept;
+
+  // moves time forward to `to`, calling `on_expired(id)` for every timer that
+  // expires meanwhile (it may `arm`/`cancel` any timer, including `id`)
+  template <typename on_expired_fn>
+  void advance(tick_t const to, on_expired_fn &&on_expired) {
+    while (current < to) {
+      if (num_armed == 0) {
+        current = to;
+        break;
+      }
+      current = skip_idle(to);
+      if (current == to) {
+        break;
+      }
+      ++current;
+      cascade();
+
+      auto &head{heads[slot_index(0, current)]};
+      while (head != nil) {
+        auto const id{head};
+        cancel(id);
+        on_expired(id);
+      }
+    }
+  }
+
+  // how many ticks from `now()` until `advance` may have to do something
+  // (i.e. a lower bound of the nearest expiry), or `-1` if nothing is armed
+  [[nodiscard]] tick_t ticks_until_next() const noexcept;
+
+private:
+  static int constexpr bits_per_level{8};
+  static int constexpr levels{4};
+  static std::uint32_t constexpr slots_per_level{1u << bits_per_level};
+  static std::uint32_t constexpr slot_mask{slots_per_level - 1};
+  // anything further in the future is parked at the top level's horizon (& is
+  // re-placed once it gets there)
+  static tick_t constexpr horizon{tick_t{1} << (bits_per_level * levels)};
+  static std::uint32_t constexpr nil{~std::uint32_t{0}};
+
+  [[nodiscard]] static std::uint32_t slot_index(int const level,
+                                                tick_t const tick) noexcept {
+    return static_cast<std::uint32_t>(level) * slots_per_level +
+           static_cast<std::uint32_t>(
+               (tick >> (bits_per_level * level)) & slot_mask);
+  }
+
+  void insert(timer_id const id);
+  // moves the timers of higher levels due at `current` one level down
+  void cascade();
+  // the last tick (`<= to`) up to which nothing can happen
+  [[nodiscard]] tick_t skip_idle(tick_t const to) const noexcept;
+
+  tick_t current{0};
+  std::size_t num_armed{0};
+  std::size_t per_level[levels]{};
+
+  std::uint32_t heads[levels * slots_per_level];
+
+  // per timer id
+  std::vector<tick_t> expiries;
+  std::vector<std::uint32_t> next;
+  std::vector<std::uint32_t> prev;
+  std::vector<std::uint32_t> slot_of; // `nil` ~ not armed
+};
+
+} // namespace exec_path_args::os_wrapper
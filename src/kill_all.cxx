@@ -0,0 +1,37 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/kill_all.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+void kill_all(exec_path_args *const cmds, std::size_t const count) {
+  std::vector<bool> signaled(count);
+  for (std::size_t i{0}; i < count; ++i) {
+    signaled[i] = cmds[i].send_kill();
+  }
+
+  for (std::size_t i{0}; i < count; ++i) {
+    if (signaled[i]) {
+      cmds[i].reap_killed();
+    }
+  }
+}
+
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,118 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/latency_histogram.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+namespace exec_path_args::os_wrapper {
+
+void latency_histogram::record(long long value_ns) noexcept {
+  value_ns = std::clamp(value_ns, 0LL, max_value);
+
+  ++counts[bucket_of(value_ns)];
+  min_ns = (total_count == 0) ? value_ns : std::min(min_ns, value_ns);
+  max_ns = (total_count == 0) ? value_ns : std::max(max_ns, value_ns);
+  sum_ns += static_cast<double>(value_ns);
+  ++total_count;
+}
+
+void latency_histogram::merge(latency_histogram const &other) noexcept {
+  if (other.total_count == 0) {
+    return;
+  }
+  for (std::size_t i{0}; i < num_buckets; ++i) {
+    counts[i] += other.counts[i];
+  }
+  min_ns = (total_count == 0) ? other.min_ns : std::min(min_ns, other.min_ns);
+  max_ns = (total_count == 0) ? other.max_ns : std::max(max_ns, other.max_ns);
+  sum_ns += other.sum_ns;
+  total_count += other.total_count;
+}
+
+void latency_histogram::reset() noexcept { *this = latency_histogram{}; }
+
+double latency_histogram::mean() const noexcept {
+  return (total_count == 0) ? 0.0
+                            : sum_ns / static_cast<double>(total_count);
+}
+
+long long latency_histogram::quantile(double const q) const noexcept {
+  if (total_count == 0) {
+    return 0;
+  }
+  // 1-based rank of the wanted value
+  auto const wanted{std::ceil(std::clamp(q, 0.0, 1.0) *
+                              static_cast<double>(total_count))};
+  auto const rank{std::clamp<std::uint64_t>(
+      static_cast<std::uint64_t>(wanted), 1, total_count)};
+
+  std::uint64_t seen{0};
+  for (std::size_t i{0}; i < num_buckets; ++i) {
+    seen += counts[i];
+    if (rank <= seen) {
+      return std::clamp(highest_of(i), min_ns, max_ns);
+    }
+  }
+  return max_ns; // (unreachable)
+}
+
+std::vector<latency_histogram::bucket> latency_histogram::buckets() const {
+  std::vector<bucket> result;
+  for (std::size_t i{0}; i < num_buckets; ++i) {
+    if (counts[i] != 0) {
+      result.push_back(bucket{lowest_of(i), highest_of(i), counts[i]});
+    }
+  }
+  return result;
+}
+
+// `[0, sub_buckets)` map 1:1, then each power of 2 `[2^e, 2^(e+1))` is split
+// into `sub_buckets` buckets by the `sub_bucket_bits` bits below the highest
+// set one
+std::size_t latency_histogram::bucket_of(long long const value) noexcept {
+  if (value < sub_buckets) {
+    return static_cast<std::size_t>(value);
+  }
+  auto const exponent{63 - __builtin_clzll(static_cast<unsigned long long>(
+                               value))};
+  auto const shift{exponent - sub_bucket_bits};
+  auto const sub{(value >> shift) & (sub_buckets - 1)};
+  return static_cast<std::size_t>(sub_buckets * (shift + 1) + sub);
+}
+
+long long latency_histogram::lowest_of(std::size_t const index) noexcept {
+  auto const i{static_cast<long long>(index)};
+  if (i < sub_buckets) {
+    return i;
+  }
+  auto const shift{i / sub_buckets - 1};
+  return (sub_buckets + i % sub_buckets) << shift;
+}
+
+long long latency_histogram::highest_of(std::size_t const index) noexcept {
+  auto const i{static_cast<long long>(index)};
+  if (i < sub_buckets) {
+    return i;
+  }
+  return lowest_of(index) + (1LL << (i / sub_buckets - 1)) - 1;
+}
+
+} // namespace exec_path_args::os_wrapper
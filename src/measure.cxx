@@ -0,0 +1,152 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/measure.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "exec_path_args/exec_path_args.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+namespace {
+
+void run_once(std::string const &path, std::vector<std::string> const &args,
+              spawn_options const &options, bool const ignore_failures,
+              measurement::run &result) {
+  exec_path_args cmd{std::string{path}, std::vector<std::string>{args},
+                     spawn_options{options}};
+  if (options.discard_output) {
+    cmd.finish();
+  } else {
+    // keep the pipes drained, so the child can't block on a full one
+    static int constexpr poll_ms{10};
+    while (cmd.update_and_get_state(poll_ms).current !=
+           exec_path_args::state::finished) {
+      static_cast<void>(cmd.get_stdout());
+      static_cast<void>(cmd.get_stderr());
+    }
+  }
+
+  if (!ignore_failures &&
+      ((cmd.get_exit_reason() != exec_path_args::exit_reason::exited) ||
+       (cmd.get_return_code() != 0))) {
+    throw std::runtime_error{"cannot measure command - '" + path +
+                             "' failed (exit code or signal " +
+                             std::to_string(cmd.get_return_code()) + ")!"};
+  }
+
+  auto const usage{cmd.get_resource_usage()};
+  result.wall_ns = std::llround(cmd.time_running_ms() * 1'000'000);
+  result.user_cpu_ns = usage.user_cpu_ns;
+  result.system_cpu_ns = usage.system_cpu_ns;
+  result.max_rss_kib = usage.max_rss_kib;
+  result.return_code = cmd.get_return_code();
+}
+
+// nearest-rank, `p` in `[0, 100]`; `sorted` isn't empty
+double percentile(std::vector<double> const &sorted, double const p) {
+  auto const rank{static_cast<std::size_t>(
+      std::ceil(p / 100 * static_cast<double>(sorted.size())))};
+  return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+measurement::summary summarize(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  auto const n{static_cast<double>(values.size())};
+
+  double sum{0.0};
+  for (auto const v : values) {
+    sum += v;
+  }
+  double const mean{sum / n};
+  double squares{0.0};
+  for (auto const v : values) {
+    squares += (v - mean) * (v - mean);
+  }
+
+  return {mean,
+          values.size() > 1 ? std::sqrt(squares / (n - 1)) : 0.0,
+          values.front(),
+          percentile(values, 50),
+          percentile(values, 95),
+          percentile(values, 99),
+          values.back()};
+}
+
+std::size_t count_outliers(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  double const q1{percentile(values, 25)};
+  double const q3{percentile(values, 75)};
+  double const fence{1.5 * (q3 - q1)};
+  return static_cast<std::size_t>(
+      std::count_if(values.begin(), values.end(), [&](double const v) {
+        return (v < q1 - fence) || (q3 + fence < v);
+      }));
+}
+
+} // namespace
+
+measurement measure(std::string const &path,
+                    std::vector<std::string> const &args, int const runs,
+                    int const warmup, measure_options const &options) {
+  if (runs <= 0) {
+    throw std::runtime_error{
+        "cannot measure command - number of runs must be positive!"};
+  } else if (warmup < 0) {
+    throw std::runtime_error{
+        "cannot measure command - number of warmup runs can't be negative!"};
+  }
+
+  auto spawn{options.spawn};
+  spawn.discard_output = options.discard_output;
+
+  measurement result{};
+  measurement::run scratch{};
+  for (int k{0}; k < warmup; ++k) {
+    run_once(path, args, spawn, options.ignore_failures, scratch);
+  }
+
+  result.runs.resize(static_cast<std::size_t>(runs));
+  for (auto &run : result.runs) {
+    run_once(path, args, spawn, options.ignore_failures, run);
+  }
+
+  static auto constexpr to_ms = [](long long const ns) -> double {
+    return static_cast<double>(ns) / 1'000'000;
+  };
+  std::vector<double> wall, user, system, rss;
+  for (auto const &run : result.runs) {
+    wall.push_back(to_ms(run.wall_ns));
+    user.push_back(to_ms(run.user_cpu_ns));
+    system.push_back(to_ms(run.system_cpu_ns));
+    rss.push_back(static_cast<double>(run.max_rss_kib));
+  }
+  result.wall_ms = summarize(wall);
+  result.user_cpu_ms = summarize(std::move(user));
+  result.system_cpu_ms = summarize(std::move(system));
+  result.max_rss_kib = summarize(std::move(rss));
+  result.wall_outliers = count_outliers(std::move(wall));
+  return result;
+}
+
+} // namespace exec_path_args::os_wrapper
@@ -19,51 +19,32 @@
 
 #include "exec_path_args/pipe_helper.hxx"
 
+#include <fcntl.h>
 #include <unistd.h>
 
-#include <iostream>
 #include <utility>
 
 #include "impl/syscall_helper.hxx"
 
 namespace exec_path_args::os_wrapper {
 
-namespace {
-
-void close_fd(int &fd) noexcept {
-  if (fd != invalid_fd) {
-    // https://linux.die.net/man/2/close
-    if (close(fd) == -1) {
-      auto const errno_val{current_errno()};
-      switch (errno_val) {
-      case EBADF:
-        std::cerr << "`close` failed - invalid file descriptor!\n";
-        break;
-      case EINTR:
-        std::cerr << "`close` failed - was interrupted by a signal!\n";
-        break;
-      case EIO:
-        std::cerr << "`close` failed - I/O error occurred!\n";
-        break;
-      default:
-        std::cerr << "`close` failed - by https://linux.die.net/man/2/close "
-                     "unspecified `errno` "
-                  << errno_val << "!\n";
-        break;
-      }
-    }
-    fd = invalid_fd;
-  }
-}
-
-} // namespace
-
 void swap(pipe_helper &lhs, pipe_helper &rhs) noexcept {
   std::swap(lhs.fds[0], rhs.fds[0]);
   std::swap(lhs.fds[1], rhs.fds[1]);
 }
 
-void pipe_helper::init() { EXEC_PATH_ARGS_SYSCALL_HELPER(pipe(fds)); }
+void pipe_helper::init(int const flags) {
+  EXEC_PATH_ARGS_SYSCALL_HELPER(pipe2(fds, O_CLOEXEC | flags));
+}
+
+void pipe_helper::set_capacity(int const bytes) {
+  auto const fd{fds[0] != invalid_fd ? fds[0] : fds[1]};
+  EXEC_PATH_ARGS_SYSCALL_HELPER(fcntl(fd, F_SETPIPE_SZ, bytes));
+}
+
+void pipe_helper::set_nonblocking_in() {
+  EXEC_PATH_ARGS_SYSCALL_HELPER(fcntl(fds[1], F_SETFL, O_NONBLOCK));
+}
 
 pipe_helper::~pipe_helper() noexcept {
   close_out();
@@ -86,4 +67,12 @@ void pipe_helper::close_out() noexcept { close_fd(fds[0]); }
 
 void pipe_helper::close_in() noexcept { close_fd(fds[1]); }
 
+native_fd_t pipe_helper::release_out() noexcept {
+  return std::exchange(fds[0], invalid_fd);
+}
+
+native_fd_t pipe_helper::release_in() noexcept {
+  return std::exchange(fds[1], invalid_fd);
+}
+
 } // namespace exec_path_args::os_wrapper
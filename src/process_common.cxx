@@ -0,0 +1,264 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "impl/process_common.hxx"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "impl/syscall_helper.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+// copied from
+// <https://github.com/Ruzovej/cxxet/blob/main/include/public/cxxet/timepoint.hxx>
+// & simplified:
+long long now_ns() noexcept {
+  // https://stackoverflow.com/a/42658433
+  // https://www.man7.org/linux/man-pages/man3/clock_gettime.3.html
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return static_cast<long long>(t.tv_sec * 1'000'000'000 + t.tv_nsec);
+}
+
+void acquire_pipe(pipe_helper &p, int const capacity) {
+  p.init();
+  if (0 < capacity) {
+    p.set_capacity(capacity);
+  }
+}
+
+void prepare_child_fds(
+    pending_spawn &pending, spawn_options const &options, pipe_helper &in,
+    pipe_helper &out, pipe_helper &err,
+    std::function<pipe_helper &(int const child_fd)> const &capture) {
+  auto &setup{pending.setup};
+
+  if (options.stdin_fd != invalid_fd) {
+    setup.redirect(options.stdin_fd, STDIN_FILENO);
+  } else {
+    acquire_pipe(in, options.stdin_pipe_capacity);
+    in.set_nonblocking_in(); // (see `exec_path_args::try_send_to_stdin`)
+    setup.redirect(in.get_out(), STDIN_FILENO);
+  }
+  if (options.discard_output) {
+    setup.redirect(dev_null(), STDOUT_FILENO);
+    setup.redirect(dev_null(), STDERR_FILENO);
+  } else {
+    acquire_pipe(out, options.stdout_pipe_capacity);
+    acquire_pipe(err, options.stderr_pipe_capacity);
+    setup.redirect(out.get_in(), STDOUT_FILENO);
+    setup.redirect(err.get_in(), STDERR_FILENO);
+  }
+
+  for (auto const &extra : options.extra_fds) {
+    if (extra.parent_fd == invalid_fd) {
+      auto &captured{capture(extra.child_fd)};
+      acquire_pipe(captured);
+      setup.redirect(captured.get_in(), extra.child_fd);
+    } else {
+      setup.redirect(extra.parent_fd, extra.child_fd);
+    }
+  }
+
+  acquire_pipe(pending.exec_error_pipe);
+  setup.error_fd = pending.exec_error_pipe.get_in();
+}
+
+void fork_child(pending_spawn &pending, char *const argv[]) {
+  auto const pid{EXEC_PATH_ARGS_SYSCALL_HELPER(fork())};
+  if (pid == 0) // Child process
+  {
+    pending.setup.run(argv);
+  } // else ... parent process
+
+  static_assert(std::is_same_v<std::decay_t<decltype(pid)>, process_handle_t>);
+  pending.pid = pid;
+  pending.exec_error_pipe.close_in();
+}
+
+native_fd_t await_exec(pending_spawn &pending) {
+  if (child_error err; wait_for_exec(pending.exec_error_pipe.get_out(), err)) {
+    // it has already `_Exit`ed (or is just about to), so don't leave a
+    // zombie behind:
+    siginfo_t status{};
+    EXEC_PATH_ARGS_SYSCALL_HELPER(
+        waitid(P_PID, pending.pid, &status, WEXITED));
+
+    throw std::runtime_error{"failed to spawn child process - " +
+                             describe(err)};
+  }
+  pending.exec_error_pipe.close_out();
+
+  // https://man7.org/linux/man-pages/man2/pidfd_open.2.html
+  // (it's always `O_CLOEXEC`); the child can't be reaped before this, so it
+  // refers to the right process
+  auto const pid_fd{static_cast<native_fd_t>(
+      syscall(static_cast<long>(SYS_pidfd_open), pending.pid, 0))};
+  if (pid_fd == invalid_fd) {
+    auto const errno_val{current_errno()};
+    // it can't be tracked, so get rid of it
+    ::kill(pending.pid, SIGKILL);
+    siginfo_t status{};
+    waitid(P_PID, pending.pid, &status, WEXITED);
+    throw std::runtime_error{"cannot track child process - `pidfd_open` "
+                             "failed with errno " +
+                             std::to_string(errno_val) + "!"};
+  }
+  return pid_fd;
+}
+
+std::size_t write_pieces(native_fd_t const fd,
+                         std::string_view const *const pieces,
+                         std::size_t const count, bool const block,
+                         bool *const reader_gone) {
+  // https://man7.org/linux/man-pages/man2/writev.2.html
+  static std::size_t constexpr batch{64}; // (far below `IOV_MAX`)
+  iovec iov[batch];
+  std::size_t total{0};
+  std::size_t k{0};      // the first piece not written completely
+  std::size_t offset{0}; // ... & how much of it is
+  while (true) {
+    while ((k < count) && (offset == pieces[k].size())) {
+      ++k;
+      offset = 0;
+    }
+    if (k == count) {
+      return total;
+    }
+
+    int n{0};
+    for (auto j{k}; (j < count) && (n < static_cast<int>(batch)); ++j) {
+      auto const skip{j == k ? offset : 0};
+      if (pieces[j].size() != skip) {
+        iov[n++] = {const_cast<char *>(pieces[j].data()) + skip,
+                    pieces[j].size() - skip};
+      }
+    }
+    ssize_t written;
+    do {
+      written = n == 1 ? write(fd, iov[0].iov_base, iov[0].iov_len)
+                       : writev(fd, iov, n);
+    } while ((written == -1) && (current_errno() == EINTR));
+    if (written == -1) {
+      if ((current_errno() == EPIPE) && (reader_gone != nullptr)) {
+        *reader_gone = true;
+        return total;
+      } else if (current_errno() != EAGAIN) {
+        EXEC_PATH_ARGS_SYSCALL_HELPER(written); // (throws)
+      } else if (!block) {
+        return total;
+      }
+      pollfd pfd{fd, POLLOUT, 0};
+      int ready;
+      do {
+        ready = poll(&pfd, 1, -1);
+      } while ((ready == -1) && (current_errno() == EINTR));
+      EXEC_PATH_ARGS_SYSCALL_HELPER(ready);
+      continue;
+    }
+
+    total += static_cast<std::size_t>(written);
+    for (auto left{static_cast<std::size_t>(written)}; left != 0;) {
+      auto const rest{pieces[k].size() - offset};
+      if (left < rest) {
+        offset += left;
+        left = 0;
+      } else {
+        left -= rest;
+        ++k;
+        offset = 0;
+      }
+    }
+  }
+}
+
+sigpipe_guard::sigpipe_guard() noexcept {
+  sigset_t sigpipe;
+  sigemptyset(&sigpipe);
+  sigaddset(&sigpipe, SIGPIPE);
+  pthread_sigmask(SIG_BLOCK, &sigpipe, &previous_mask);
+  sigset_t pending;
+  sigpending(&pending);
+  was_pending = sigismember(&pending, SIGPIPE) == 1;
+}
+
+sigpipe_guard::~sigpipe_guard() noexcept {
+  sigset_t pending;
+  sigpending(&pending);
+  if (!was_pending && (sigismember(&pending, SIGPIPE) == 1)) {
+    sigset_t sigpipe;
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+    timespec const no_wait{};
+    while ((sigtimedwait(&sigpipe, nullptr, &no_wait) == -1) &&
+           (errno == EINTR)) {
+    }
+  }
+  pthread_sigmask(SIG_SETMASK, &previous_mask, nullptr);
+}
+
+native_fd_t dev_null() {
+  // https://man7.org/linux/man-pages/man4/null.4.html
+  static native_fd_t const fd{EXEC_PATH_ARGS_SYSCALL_HELPER(
+      open("/dev/null", O_WRONLY | O_CLOEXEC))};
+  return fd;
+}
+
+exec_path_args::resource_usage to_resource_usage(rusage const &ru) noexcept {
+  static auto constexpr to_ns = [](timeval const &tv) -> long long {
+    return static_cast<long long>(tv.tv_sec) * 1'000'000'000 +
+           static_cast<long long>(tv.tv_usec) * 1'000;
+  };
+  return {to_ns(ru.ru_utime), to_ns(ru.ru_stime), ru.ru_maxrss};
+}
+
+exec_path_args::exit_reason
+classify_exit(siginfo_t const &status, bool const cpu_limited) noexcept {
+  if (status.si_code == CLD_EXITED) {
+    return exec_path_args::exit_reason::exited;
+  }
+  switch (status.si_status) {
+  case SIGXCPU:
+    return exec_path_args::exit_reason::cpu_limit_exceeded;
+  case SIGXFSZ:
+    return exec_path_args::exit_reason::file_size_limit_exceeded;
+  case SIGKILL:
+    // the kernel sends it once the hard limit is reached (`do_kill` relabels
+    // its own `SIGKILL`s)
+    return cpu_limited ? exec_path_args::exit_reason::cpu_limit_exceeded
+                       : exec_path_args::exit_reason::signaled;
+  default:
+    return exec_path_args::exit_reason::signaled;
+  }
+}
+
+} // namespace exec_path_args::os_wrapper
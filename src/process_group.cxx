@@ -0,0 +1,1119 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/process_group.hxx"
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "impl/argv_arena.hxx"
+#include "impl/child_setup.hxx"
+#include "impl/process_common.hxx"
+#include "impl/reaper.hxx"
+#include "impl/syscall_helper.hxx"
+#include "impl/timer_wheel.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+namespace {
+
+[[nodiscard]] long long now_ms() noexcept { return now_ns() / 1'000'000; }
+
+// rounded up - so that no timer expires early
+[[nodiscard]] long long to_ms_ceil(long long const ns) noexcept {
+  return (ns + 999'999) / 1'000'000;
+}
+
+// the next (unsigned, decimal) number of `text`, skipping anything before it
+// (consumed too); `-1` if there's none
+[[nodiscard]] long long next_number(std::string_view &text) noexcept {
+  auto const is_digit = [](char const c) { return ('0' <= c) && (c <= '9'); };
+  std::size_t k{0};
+  while ((k < text.size()) && !is_digit(text[k])) {
+    ++k;
+  }
+  if (k == text.size()) {
+    return -1;
+  }
+  long long value{0};
+  for (; (k < text.size()) && is_digit(text[k]); ++k) {
+    value = 10 * value + (text[k] - '0');
+  }
+  text.remove_prefix(k);
+  return value;
+}
+
+// `statm` & `schedstat` hold those files (`/proc/<pid>/...`); returns whether
+// they're complete enough & of a child that's still alive
+[[nodiscard]] bool parse_sample(std::string_view statm,
+                                std::string_view schedstat,
+                                process_group::resource_sample &sample) {
+  static long const page_kib{sysconf(_SC_PAGESIZE) / 1024};
+
+  // (in pages) size, resident, ...
+  auto const size{next_number(statm)};
+  auto const resident{next_number(statm)};
+  // on the CPU (in ns), waiting for it, ...
+  auto const cpu_ns{next_number(schedstat)};
+  // (an exited, but not reaped yet child has no address space anymore - all
+  // zeroes then)
+  if ((size <= 0) || (resident < 0) || (cpu_ns < 0)) {
+    return false;
+  }
+  sample.vm_size_kib = static_cast<long>(size) * page_kib;
+  sample.rss_kib = static_cast<long>(resident) * page_kib;
+  sample.cpu_ns = cpu_ns;
+  return true;
+}
+
+} // namespace
+
+void swap(process_group &lhs, process_group &rhs) noexcept {
+  using std::swap;
+
+  swap(lhs.t, rhs.t);
+  swap(lhs.inputs, rhs.inputs);
+  swap(lhs.stdin_feeds, rhs.stdin_feeds);
+  swap(lhs.inactivity, rhs.inactivity);
+  swap(lhs.sampled, rhs.sampled);
+  swap(lhs.path_ids_by_name, rhs.path_ids_by_name);
+  swap(lhs.interned_paths, rhs.interned_paths);
+  swap(lhs.stats_enabled, rhs.stats_enabled);
+  swap(lhs.stats_by_template, rhs.stats_by_template);
+  swap(lhs.sampling_interval_ms, rhs.sampling_interval_ms);
+  swap(lhs.sampling_capacity, rhs.sampling_capacity);
+  swap(lhs.epoll_fd, rhs.epoll_fd);
+  swap(lhs.num_running, rhs.num_running);
+  swap(lhs.num_watched, rhs.num_watched);
+  swap(lhs.first_ready, rhs.first_ready);
+  swap(lhs.timers, rhs.timers);
+}
+
+process_group::process_group() noexcept = default;
+
+process_group::process_group(process_group &&rhs) noexcept
+    : t{std::move(rhs.t)}, inputs{std::move(rhs.inputs)},
+      stdin_feeds{std::move(rhs.stdin_feeds)},
+      inactivity{std::move(rhs.inactivity)}, sampled{std::move(rhs.sampled)},
+      path_ids_by_name{std::move(rhs.path_ids_by_name)},
+      interned_paths{std::move(rhs.interned_paths)},
+      stats_enabled{rhs.stats_enabled},
+      stats_by_template{std::move(rhs.stats_by_template)},
+      sampling_interval_ms{rhs.sampling_interval_ms},
+      sampling_capacity{rhs.sampling_capacity},
+      epoll_fd{std::exchange(rhs.epoll_fd, invalid_fd)},
+      num_running{std::exchange(rhs.num_running, 0)},
+      num_watched{std::exchange(rhs.num_watched, 0)},
+      first_ready{std::exchange(rhs.first_ready, 0)},
+      timers{std::move(rhs.timers)} {}
+
+process_group &process_group::operator=(process_group &&rhs) noexcept {
+  if (this != &rhs) {
+    process_group tmp{std::move(rhs)};
+    swap(*this, tmp);
+  }
+  return *this;
+}
+
+process_group::~process_group() noexcept {
+  for (std::size_t i{0}; i < size(); ++i) {
+    if (t.states[i] == state::running) {
+      ::kill(t.pids[i], SIGKILL);
+      reaper::adopt_or_reap(t.pids[i],
+                            std::exchange(t.pid_fds[i], invalid_fd));
+    }
+    close_fd(t.stdin_fds[i]);
+    close_fd(t.stdout_fds[i]);
+    close_fd(t.stderr_fds[i]);
+  }
+  for (auto &[i, s] : sampled) {
+    close_fd(s.statm_fd);
+    close_fd(s.schedstat_fd);
+  }
+  close_fd(epoll_fd);
+}
+
+void process_group::reserve(std::size_t const capacity) {
+  t.states.reserve(capacity);
+  t.flags.reserve(capacity);
+  t.pids.reserve(capacity);
+  t.pid_fds.reserve(capacity);
+  t.spawned_ns.reserve(capacity);
+  t.finished_ns.reserve(capacity);
+  t.return_codes.reserve(capacity);
+  t.reasons.reserve(capacity);
+  t.deadlines_ms.reserve(capacity);
+  t.grace_periods_ms.reserve(capacity);
+  t.stdin_fds.reserve(capacity);
+  t.stdout_fds.reserve(capacity);
+  t.stderr_fds.reserve(capacity);
+  t.stdout_buffers.reserve(capacity);
+  t.stderr_buffers.reserve(capacity);
+  t.template_ids.reserve(capacity);
+  inputs.reserve(capacity);
+}
+
+process_group::index_t process_group::add(std::string &&path,
+                                          std::vector<std::string> &&args) {
+  return add(std::move(path), std::move(args),
+             std::shared_ptr<spawn_options const>{});
+}
+
+process_group::index_t process_group::add(std::string &&path,
+                                          std::vector<std::string> &&args,
+                                          spawn_options &&options) {
+  return add(std::move(path), std::move(args),
+             std::make_shared<spawn_options const>(std::move(options)));
+}
+
+process_group::index_t
+process_group::add(std::string &&path, std::vector<std::string> &&args,
+                   std::shared_ptr<spawn_options const> options) {
+  // (ids of all its timers must fit too)
+  if (std::numeric_limits<index_t>::max() / timer_kinds <= size()) {
+    throw std::runtime_error{"cannot add another child - group is full!"};
+  }
+  auto const i{static_cast<index_t>(size())};
+  auto const path_id{intern(std::move(path))};
+  inputs.emplace(i, spawn_inputs{path_id, std::move(args), std::move(options)});
+
+  t.states.push_back(state::ready);
+  t.flags.push_back(0);
+  t.pids.push_back(invalid_process_handle);
+  t.pid_fds.push_back(invalid_fd);
+  t.spawned_ns.push_back(0);
+  t.finished_ns.push_back(0);
+  t.return_codes.push_back(0);
+  t.reasons.push_back(exit_reason::exited);
+  t.deadlines_ms.push_back(-1);
+  t.grace_periods_ms.push_back(0);
+  t.stdin_fds.push_back(invalid_fd);
+  t.stdout_fds.push_back(invalid_fd);
+  t.stderr_fds.push_back(invalid_fd);
+  t.stdout_buffers.emplace_back();
+  t.stderr_buffers.emplace_back();
+  t.template_ids.push_back(path_id);
+
+  return i;
+}
+
+std::vector<process_group::spawn_failure>
+process_group::spawn_all(std::size_t const max_count) {
+  if (epoll_fd == invalid_fd) {
+    epoll_fd = EXEC_PATH_ARGS_SYSCALL_HELPER(epoll_create1(EPOLL_CLOEXEC));
+  }
+
+  // in chunks, so there aren't too many pipes etc. prepared at once
+  static std::size_t constexpr chunk_size{32};
+
+  std::vector<spawn_failure> failures;
+  std::vector<index_t> chunk;
+  chunk.reserve(chunk_size);
+
+  std::size_t spawned{0};
+  auto i{static_cast<std::size_t>(first_ready)};
+  while ((i < size()) && (spawned < max_count)) {
+    chunk.clear();
+    for (; (i < size()) && (chunk.size() < chunk_size) &&
+           (spawned + chunk.size() < max_count);
+         ++i) {
+      if (t.states[i] == state::ready) {
+        chunk.push_back(static_cast<index_t>(i));
+      }
+    }
+    auto const failed_before{failures.size()};
+    spawn_chunk(chunk, failures);
+    // (the failed ones don't count, the next ready ones are tried instead)
+    spawned += chunk.size() - (failures.size() - failed_before);
+  }
+
+  std::sort(failures.begin(), failures.end(),
+            [](spawn_failure const &lhs, spawn_failure const &rhs) {
+              return lhs.index < rhs.index;
+            });
+
+  // everything before `i` was attempted - only those that failed stay ready
+  first_ready = failures.empty() ? static_cast<index_t>(i)
+                                 : std::min(failures.front().index,
+                                            static_cast<index_t>(i));
+
+  return failures;
+}
+
+void process_group::cancel(index_t const i) {
+  check_index(i);
+  if (t.states[i] != state::ready) {
+    throw std::runtime_error{"cannot cancel - process isn't ready!"};
+  }
+  t.states[i] = state::uninitialzied;
+  // (never needed anymore)
+  inputs.erase(i);
+  stdin_feeds.erase(i);
+}
+
+void process_group::spawn_chunk(std::vector<index_t> const &chunk,
+                                std::vector<spawn_failure> &failures) {
+  static spawn_options const default_options;
+
+  std::vector<std::optional<pending_spawn>> pendings(chunk.size());
+  // stdin, stdout & stderr
+  std::vector<std::array<pipe_helper, 3>> pipes(chunk.size());
+  std::vector<long long> forked_ns(chunk.size());
+
+  auto const failed = [&](std::size_t const k) {
+    failures.push_back(spawn_failure{chunk[k], std::current_exception()});
+    pendings[k].reset();
+    pipes[k] = {};
+  };
+
+  // 1. prepare everything
+  std::size_t total_words{0};
+  for (std::size_t k{0}; k < chunk.size(); ++k) {
+    auto const i{chunk[k]};
+    auto const &spawn{inputs.at(i)};
+    auto const &options{spawn.options ? *spawn.options : default_options};
+    try {
+      auto &[in, out, err]{pipes[k]};
+      prepare_child_fds(pendings[k].emplace(options), options, in, out, err,
+                        [](int) -> pipe_helper & {
+                          throw std::runtime_error{
+                              "invalid spawn options - process_group can't "
+                              "capture extra fds!"};
+                        });
+
+      total_words +=
+          argv_arena::words_needed(*interned_paths[spawn.path_id], spawn.args);
+    } catch (...) {
+      failed(k);
+    }
+  }
+
+  argv_arena arena{total_words};
+  std::vector<char **> argvs(chunk.size());
+  for (std::size_t k{0}; k < chunk.size(); ++k) {
+    if (pendings[k].has_value()) {
+      auto const i{chunk[k]};
+      auto const &spawn{inputs.at(chunk[k])};
+      argvs[k] = arena.emplace(*interned_paths[spawn.path_id], spawn.args);
+    }
+  }
+
+  // 2. `fork` them all
+  for (std::size_t k{0}; k < chunk.size(); ++k) {
+    auto &pending{pendings[k]};
+    if (!pending.has_value()) {
+      continue;
+    }
+    try {
+      forked_ns[k] = now_ns();
+      fork_child(*pending, argvs[k]);
+    } catch (...) {
+      failed(k);
+      continue;
+    }
+
+    auto &[in, out, err]{pipes[k]};
+    in.close_out();
+    out.close_in();
+    err.close_in();
+  }
+
+  // 3. wait until each of them `execv`s
+  for (std::size_t k{0}; k < chunk.size(); ++k) {
+    auto &pending{pendings[k]};
+    if (!pending.has_value()) {
+      continue;
+    }
+    auto const i{chunk[k]};
+    auto &[in, out, err]{pipes[k]};
+    bool execed{false};
+    auto const watched_before{num_watched};
+    try {
+      t.pid_fds[i] = await_exec(*pending);
+      execed = true;
+      watch(t.pid_fds[i], i, source::pid_fd);
+      if (out.get_out() != invalid_fd) { // see `discard_output`
+        watch(out.get_out(), i, source::stdout_pipe);
+        watch(err.get_out(), i, source::stderr_pipe);
+      }
+    } catch (...) {
+      if (execed) {
+        // it can't be tracked, so get rid of it
+        ::kill(pending->pid, SIGKILL);
+        siginfo_t status{};
+        waitid(P_PID, pending->pid, &status, WEXITED);
+        for (auto const fd : {t.pid_fds[i], out.get_out(), err.get_out()}) {
+          if (fd != invalid_fd) { // (fails for the ones not watched yet)
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+          }
+        }
+        close_fd(t.pid_fds[i]);
+        num_watched = watched_before;
+      }
+      failed(k);
+      continue;
+    }
+
+    t.pids[i] = pending->pid;
+    t.spawned_ns[i] = now_ns();
+    t.states[i] = state::running;
+    if (auto *const stats{stats_of(i)}) {
+      stats->spawn_ns.record(t.spawned_ns[i] - forked_ns[k]);
+    }
+    t.stdin_fds[i] = in.release_in();
+    t.stdout_fds[i] = out.release_out();
+    t.stderr_fds[i] = err.release_out();
+    ++num_running;
+    if ((stdin_feeds.count(i) != 0) && (t.stdin_fds[i] != invalid_fd)) {
+      watch(t.stdin_fds[i], i, source::stdin_pipe);
+    }
+
+    if (t.deadlines_ms[i] >= 0) {
+      arm_timer(i, timer_kind::deadline,
+                to_ms_ceil(t.spawned_ns[i]) + t.deadlines_ms[i]);
+    }
+    if (t.flags[i] & inactivity_set) {
+      auto &entry{inactivity.at(i)};
+      entry.last_output_ns = t.spawned_ns[i];
+      arm_timer(i, timer_kind::inactivity,
+                to_ms_ceil(t.spawned_ns[i]) + entry.timeout_ms);
+    }
+    if (sampling_interval_ms > 0) {
+      // (not worth failing the spawn over - e.g. out of fds, it just isn't
+      // sampled then)
+      auto const proc_dir{"/proc/" + std::to_string(t.pids[i])};
+      auto &s{sampled[i]};
+      s.statm_fd = open((proc_dir + "/statm").c_str(), O_RDONLY | O_CLOEXEC);
+      s.schedstat_fd =
+          open((proc_dir + "/schedstat").c_str(), O_RDONLY | O_CLOEXEC);
+      if ((s.statm_fd != invalid_fd) && (s.schedstat_fd != invalid_fd)) {
+        s.ring.resize(sampling_capacity);
+        arm_timer(i, timer_kind::sampling,
+                  next_sampling_ms(to_ms_ceil(t.spawned_ns[i])));
+      } else {
+        close_fd(s.statm_fd);
+        close_fd(s.schedstat_fd);
+        sampled.erase(i);
+      }
+    }
+
+    // not needed anymore (besides whether `RLIMIT_CPU` applies):
+    if (auto const &options{inputs.at(i).options};
+        options && options->limits(RLIMIT_CPU)) {
+      t.flags[i] |= cpu_limited;
+    }
+    inputs.erase(i);
+  }
+}
+
+std::size_t process_group::update_all(int const timeout_ms) {
+  return process_events(timeout_ms).finished;
+}
+
+void process_group::finish_all() {
+  while (num_running != 0) {
+    static_cast<void>(update_all(-1));
+  }
+}
+
+void process_group::set_deadline(index_t const i, int const timeout_ms,
+                                 int const grace_ms) {
+  check_index(i);
+  if ((timeout_ms < 0) || (grace_ms < 0)) {
+    throw std::runtime_error{"cannot set deadline - negative timeout!"};
+  } else if (t.states[i] == state::finished) {
+    throw std::runtime_error{"cannot set deadline - process is finished!"};
+  }
+
+  if (!timers) {
+    timers = std::make_unique<timer_wheel>();
+  }
+  t.deadlines_ms[i] = timeout_ms;
+  t.grace_periods_ms[i] = grace_ms;
+  if (t.states[i] == state::running) {
+    arm_timer(i, timer_kind::deadline,
+              to_ms_ceil(t.spawned_ns[i]) + timeout_ms);
+  } // else ... armed once spawned
+}
+
+void process_group::cancel_deadline(index_t const i) {
+  check_index(i);
+  t.deadlines_ms[i] = -1;
+  cancel_timer(i, timer_kind::deadline);
+}
+
+void process_group::set_inactivity_timeout(index_t const i,
+                                           int const timeout_ms,
+                                           int const grace_ms) {
+  check_index(i);
+  if ((timeout_ms < 0) || (grace_ms < 0)) {
+    throw std::runtime_error{
+        "cannot set inactivity timeout - negative timeout!"};
+  } else if (t.states[i] == state::finished) {
+    throw std::runtime_error{
+        "cannot set inactivity timeout - process is finished!"};
+  }
+
+  if (!timers) {
+    timers = std::make_unique<timer_wheel>();
+  }
+  auto &entry{inactivity[i]};
+  entry.timeout_ms = timeout_ms;
+  entry.grace_period_ms = grace_ms;
+  t.flags[i] |= inactivity_set;
+  if (t.states[i] == state::running) {
+    entry.last_output_ns = now_ns();
+    arm_timer(i, timer_kind::inactivity,
+              to_ms_ceil(entry.last_output_ns) + timeout_ms);
+  } // else ... armed once spawned
+}
+
+void process_group::cancel_inactivity_timeout(index_t const i) {
+  check_index(i);
+  inactivity.erase(i);
+  t.flags[i] &= static_cast<std::uint8_t>(~inactivity_set);
+  cancel_timer(i, timer_kind::inactivity);
+}
+
+void process_group::enable_stats() { stats_enabled = true; }
+
+void process_group::enable_sampling(int const interval_ms,
+                                    std::size_t const capacity) {
+  if ((interval_ms <= 0) || (capacity == 0)) {
+    throw std::runtime_error{
+        "cannot enable sampling - interval & capacity must be positive!"};
+  }
+  if (!timers) {
+    timers = std::make_unique<timer_wheel>();
+  }
+  sampling_interval_ms = interval_ms;
+  sampling_capacity = capacity;
+}
+
+std::vector<process_group::resource_sample>
+process_group::samples(index_t const i) const {
+  check_index(i);
+  auto const it{sampled.find(i)};
+  if (it == sampled.end()) {
+    return {};
+  }
+  auto const &ring{it->second.ring};
+  auto const taken{static_cast<std::size_t>(it->second.count)};
+  std::vector<resource_sample> result;
+  result.reserve(std::min(taken, ring.size()));
+  for (auto k{taken - std::min(taken, ring.size())}; k < taken; ++k) {
+    result.push_back(ring[k % ring.size()]);
+  }
+  return result;
+}
+
+void process_group::set_template(index_t const i, std::string &&name) {
+  check_index(i);
+  t.template_ids[i] = intern(std::move(name));
+}
+
+std::map<std::string, process_group::command_stats>
+process_group::stats() const {
+  std::map<std::string, command_stats> result;
+  for (std::size_t id{0}; id < stats_by_template.size(); ++id) {
+    if (stats_by_template[id]) {
+      result.emplace(*interned_paths[id], *stats_by_template[id]);
+    }
+  }
+  return result;
+}
+
+void process_group::kill_all() {
+  for (std::size_t i{0}; i < size(); ++i) {
+    if (t.states[i] == state::running) {
+      t.flags[i] |= kill_requested;
+      EXEC_PATH_ARGS_SYSCALL_HELPER(::kill(t.pids[i], SIGKILL));
+    }
+  }
+  finish_all();
+}
+
+void process_group::kill(index_t const i) {
+  check_index(i);
+  if (t.states[i] == state::running) {
+    t.flags[i] |= kill_requested;
+    EXEC_PATH_ARGS_SYSCALL_HELPER(::kill(t.pids[i], SIGKILL));
+    on_exit(i, true);
+  }
+}
+
+std::size_t process_group::collect_outputs() {
+  // bounded, so a (very) chatty child can't keep the caller here forever
+  static int constexpr max_rounds{64};
+
+  std::size_t bytes_read{0};
+  for (int round{0}; round < max_rounds; ++round) {
+    auto const p{process_events(0)};
+    bytes_read += p.bytes_read;
+    if (p.events == 0) {
+      break;
+    }
+  }
+  return bytes_read;
+}
+
+void process_group::shrink_to_fit() {
+  static_cast<void>(collect_outputs());
+
+  for (std::size_t i{0}; i < size(); ++i) {
+    if (t.states[i] != state::finished) {
+      continue;
+    }
+    for (auto *const fd : {&t.stdout_fds[i], &t.stderr_fds[i]}) {
+      if (*fd != invalid_fd) {
+        unwatch(*fd);
+      }
+    }
+    t.stdout_buffers[i].shrink_to_fit();
+    t.stderr_buffers[i].shrink_to_fit();
+  }
+
+  t.states.shrink_to_fit();
+  t.flags.shrink_to_fit();
+  t.pids.shrink_to_fit();
+  t.pid_fds.shrink_to_fit();
+  t.spawned_ns.shrink_to_fit();
+  t.finished_ns.shrink_to_fit();
+  t.return_codes.shrink_to_fit();
+  t.reasons.shrink_to_fit();
+  t.deadlines_ms.shrink_to_fit();
+  t.grace_periods_ms.shrink_to_fit();
+  t.stdin_fds.shrink_to_fit();
+  t.stdout_fds.shrink_to_fit();
+  t.stderr_fds.shrink_to_fit();
+  t.stdout_buffers.shrink_to_fit();
+  t.stderr_buffers.shrink_to_fit();
+  t.template_ids.shrink_to_fit();
+  // (e.g. buckets `reserve`d for children spawned since)
+  inputs.rehash(0);
+  stdin_feeds.rehash(0);
+  inactivity.rehash(0);
+  sampled.rehash(0);
+}
+
+std::vector<process_group::index_t> process_group::finished_indices() const {
+  std::vector<index_t> result;
+  for (std::size_t i{0}; i < size(); ++i) {
+    if (t.states[i] == state::finished) {
+      result.push_back(static_cast<index_t>(i));
+    }
+  }
+  return result;
+}
+
+void process_group::send_to_stdin(index_t const i,
+                                  std::string_view const data) {
+  send_to_stdin(i, &data, 1);
+}
+
+void process_group::send_to_stdin(index_t const i,
+                                  std::string_view const *const pieces,
+                                  std::size_t const count) {
+  check_stdin(i);
+  static_cast<void>(write_pieces(t.stdin_fds[i], pieces, count, true));
+}
+
+std::size_t process_group::try_send_to_stdin(index_t const i,
+                                             std::string_view const data) {
+  return try_send_to_stdin(i, &data, 1);
+}
+
+std::size_t
+process_group::try_send_to_stdin(index_t const i,
+                                 std::string_view const *const pieces,
+                                 std::size_t const count) {
+  check_stdin(i);
+  return write_pieces(t.stdin_fds[i], pieces, count, false);
+}
+
+void process_group::check_stdin(index_t const i) const {
+  check_index(i);
+  if (t.states[i] != state::running) {
+    throw std::runtime_error{
+        "cannot write to inferior stdin - process isn't running!"};
+  } else if (t.stdin_fds[i] == invalid_fd) {
+    throw std::runtime_error{
+        "cannot write to inferior stdin - stdin pipe is closed!"};
+  }
+}
+
+void process_group::close_stdin(index_t const i) {
+  check_index(i);
+  if ((t.states[i] != state::running) || (t.stdin_fds[i] == invalid_fd)) {
+    throw std::runtime_error{
+        "cannot close inferior stdin - process isn't running or invalid fd!"};
+  }
+  end_stdin(i);
+}
+
+void process_group::set_stdin_producer(index_t const i,
+                                       stdin_producer &&producer) {
+  check_index(i);
+  if (!producer) {
+    throw std::runtime_error{"cannot set stdin producer - it's empty!"};
+  } else if (t.states[i] == state::ready) {
+    if (auto const &options{inputs.at(i).options};
+        options && (options->stdin_fd != invalid_fd)) {
+      throw std::runtime_error{
+          "cannot set stdin producer - stdin isn't a pipe!"};
+    }
+  } else if ((t.states[i] != state::running) ||
+             (t.stdin_fds[i] == invalid_fd)) {
+    throw std::runtime_error{"cannot set stdin producer - process isn't "
+                             "running or stdin is closed!"};
+  } else if (stdin_feeds.count(i) == 0) {
+    watch(t.stdin_fds[i], i, source::stdin_pipe);
+  }
+  stdin_feeds[i].producer = std::move(producer);
+}
+
+std::string_view process_group::read_stdout(index_t const i) const {
+  check_index(i);
+  return t.stdout_buffers[i];
+}
+
+std::string_view process_group::read_stderr(index_t const i) const {
+  check_index(i);
+  return t.stderr_buffers[i];
+}
+
+std::string process_group::get_stdout(index_t const i) {
+  check_index(i);
+  return std::exchange(t.stdout_buffers[i], std::string{});
+}
+
+std::string process_group::get_stderr(index_t const i) {
+  check_index(i);
+  return std::exchange(t.stderr_buffers[i], std::string{});
+}
+
+process_group::state process_group::get_state(index_t const i) const {
+  check_index(i);
+  return t.states[i];
+}
+
+process_handle_t process_group::get_process_handle(index_t const i) const {
+  check_index(i);
+  return t.pids[i];
+}
+
+int process_group::get_return_code(index_t const i) const {
+  check_index(i);
+  if (t.states[i] != state::finished) {
+    throw std::runtime_error{
+        "can't obtain return code - process isn't finished!"};
+  }
+  return t.return_codes[i];
+}
+
+process_group::exit_reason
+process_group::get_exit_reason(index_t const i) const {
+  check_index(i);
+  if (t.states[i] != state::finished) {
+    throw std::runtime_error{
+        "can't obtain exit reason - process isn't finished!"};
+  }
+  return t.reasons[i];
+}
+
+double process_group::time_running_ms(index_t const i) const {
+  check_index(i);
+  if (t.states[i] == state::running) {
+    return static_cast<double>(now_ns() - t.spawned_ns[i]) / 1'000'000;
+  } else if (t.states[i] == state::finished) {
+    return static_cast<double>(t.finished_ns[i] - t.spawned_ns[i]) /
+           1'000'000;
+  }
+  throw std::runtime_error{
+      "cannot get running time - process isn't running or finished!"};
+}
+
+std::uint32_t process_group::intern(std::string &&path) {
+  auto const next_id{static_cast<std::uint32_t>(interned_paths.size())};
+  auto const [it, inserted]{path_ids_by_name.try_emplace(std::move(path),
+                                                         next_id)};
+  if (inserted) {
+    // (nodes of `std::unordered_map` don't move)
+    interned_paths.push_back(&it->first);
+  }
+  return it->second;
+}
+
+void process_group::check_index(index_t const i) const {
+  if (size() <= i) {
+    throw std::runtime_error{"invalid process_group index!"};
+  }
+}
+
+process_group::command_stats *process_group::stats_of(index_t const i) {
+  if (!stats_enabled) {
+    return nullptr;
+  }
+  auto const id{t.template_ids[i]};
+  if (stats_by_template.size() <= id) {
+    stats_by_template.resize(id + 1);
+  }
+  if (!stats_by_template[id]) {
+    stats_by_template[id] = std::make_unique<command_stats>();
+  }
+  return stats_by_template[id].get();
+}
+
+void process_group::watch(native_fd_t const fd, index_t const i,
+                          source const what) {
+  epoll_event ev{};
+  ev.events = what == source::stdin_pipe ? EPOLLOUT : EPOLLIN;
+  ev.data.u64 = (static_cast<std::uint64_t>(i) << 2) |
+                static_cast<std::uint64_t>(what);
+  EXEC_PATH_ARGS_SYSCALL_HELPER(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev));
+  ++num_watched;
+}
+
+void process_group::unwatch(native_fd_t &fd) noexcept {
+  // https://man7.org/linux/man-pages/man7/epoll.7.html (Q6: a plain `close`
+  // leaves it registered while e.g. a concurrently forked child has a copy)
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+  close_fd(fd);
+  --num_watched;
+}
+
+void process_group::arm_timer(index_t const i, timer_kind const kind,
+                              long long const expiry_ms) {
+  if (timers->size() == 0) {
+    // (nothing can expire - just don't place it relative to a stale "now")
+    timers->advance(now_ms(), [](timer_wheel::timer_id) {});
+  }
+  timers->arm(i * timer_kinds + static_cast<std::uint32_t>(kind), expiry_ms);
+}
+
+void process_group::cancel_timer(index_t const i,
+                                 timer_kind const kind) noexcept {
+  if (timers) {
+    timers->cancel(i * timer_kinds + static_cast<std::uint32_t>(kind));
+  }
+}
+
+void process_group::expire_timers() {
+  if (!timers) {
+    return;
+  }
+  timers->advance(now_ms(), [this](timer_wheel::timer_id const id) {
+    auto const i{static_cast<index_t>(id / timer_kinds)};
+    switch (static_cast<timer_kind>(id % timer_kinds)) {
+    case timer_kind::deadline:
+      on_deadline(i);
+      break;
+    case timer_kind::inactivity:
+      on_inactivity(i);
+      break;
+    case timer_kind::sampling:
+      on_sampling(i);
+      break;
+    }
+  });
+}
+
+void process_group::on_deadline(index_t const i) {
+  if (t.states[i] != state::running) {
+    return;
+  }
+  if (!(t.flags[i] & timed_out)) {
+    time_out(i, t.grace_periods_ms[i]);
+  } else {
+    EXEC_PATH_ARGS_SYSCALL_HELPER(::kill(t.pids[i], SIGKILL));
+  }
+}
+
+void process_group::on_inactivity(index_t const i) {
+  if ((t.states[i] != state::running) || (t.flags[i] & timed_out)) {
+    return;
+  }
+  auto const &entry{inactivity.at(i)};
+  auto const expiry_ms{to_ms_ceil(entry.last_output_ns) + entry.timeout_ms};
+  if (timers->now() < expiry_ms) {
+    arm_timer(i, timer_kind::inactivity, expiry_ms);
+    return;
+  }
+  t.flags[i] |= inactive;
+  time_out(i, entry.grace_period_ms);
+}
+
+long long process_group::next_sampling_ms(long long const now_ms) const {
+  // aligned to multiples of the interval - so all the children get sampled
+  // in the same wakeup
+  return (now_ms / sampling_interval_ms + 1) * sampling_interval_ms;
+}
+
+void process_group::on_sampling(index_t const i) {
+  auto const it{sampled.find(i)};
+  if ((it == sampled.end()) || (it->second.statm_fd == invalid_fd)) {
+    return;
+  }
+  auto &s{it->second};
+  arm_timer(i, timer_kind::sampling, next_sampling_ms(timers->now()));
+
+  // (way more than either of them ever takes)
+  char statm[128];
+  char schedstat[64];
+  auto const statm_bytes{pread(s.statm_fd, statm, sizeof(statm), 0)};
+  auto const schedstat_bytes{
+      pread(s.schedstat_fd, schedstat, sizeof(schedstat), 0)};
+  if ((statm_bytes <= 0) || (schedstat_bytes <= 0)) {
+    return; // e.g. it has just exited
+  }
+
+  resource_sample sample{};
+  if (!parse_sample({statm, static_cast<std::size_t>(statm_bytes)},
+                    {schedstat, static_cast<std::size_t>(schedstat_bytes)},
+                    sample)) {
+    return;
+  }
+  sample.since_spawn_ns = now_ns() - t.spawned_ns[i];
+  s.ring[s.count % s.ring.size()] = sample;
+  ++s.count;
+}
+
+void process_group::time_out(index_t const i, int const grace_ms) {
+  t.flags[i] |= timed_out;
+  // (a terminated, but not yet reaped child can still be signaled)
+  EXEC_PATH_ARGS_SYSCALL_HELPER(::kill(t.pids[i], SIGTERM));
+  cancel_timer(i, timer_kind::inactivity);
+
+  // the same timer sends `SIGKILL` - but not past a (still pending) deadline,
+  // e.g. when timed out for inactivity first
+  auto expiry_ms{to_ms_ceil(now_ns()) + grace_ms};
+  if (t.deadlines_ms[i] >= 0) {
+    auto const deadline_ms{to_ms_ceil(t.spawned_ns[i]) + t.deadlines_ms[i]};
+    if (timers->now() < deadline_ms) {
+      expiry_ms = std::min(expiry_ms, deadline_ms);
+    }
+  }
+  arm_timer(i, timer_kind::deadline, expiry_ms);
+}
+
+process_group::processed process_group::process_events(int const timeout_ms) {
+  processed result;
+  if (num_watched == 0) {
+    return result; // nothing could ever happen
+  }
+
+  static int constexpr max_events{256};
+  epoll_event events[max_events];
+
+  auto const until_ns{now_ns() + timeout_ms * 1'000'000LL};
+  int n;
+  for (;;) {
+    expire_timers();
+
+    // woken up (also) for the nearest timer, unless waiting less anyway
+    auto wait_ms{timeout_ms};
+    if (timeout_ms > 0) {
+      wait_ms = static_cast<int>(
+          std::max((until_ns - now_ns() + 999'999) / 1'000'000, 0LL));
+    }
+    auto const next_timer{timers ? timers->ticks_until_next() : -1};
+    bool const woken_by_timer{(next_timer >= 0) &&
+                              ((wait_ms < 0) || (next_timer < wait_ms))};
+    if (woken_by_timer) {
+      wait_ms = static_cast<int>(next_timer);
+    }
+
+    do {
+      n = epoll_wait(epoll_fd, events, max_events, wait_ms);
+    } while ((n == -1) && (current_errno() == EINTR));
+    EXEC_PATH_ARGS_SYSCALL_HELPER(n);
+
+    if ((n != 0) || !woken_by_timer) {
+      break;
+    }
+  }
+
+  result.events = static_cast<std::size_t>(n);
+  for (int e{0}; e < n; ++e) {
+    auto const i{static_cast<index_t>(events[e].data.u64 >> 2)};
+    auto const what{static_cast<source>(events[e].data.u64 & 0b11)};
+    if (what == source::pid_fd) {
+      result.finished += on_exit(i) ? 1 : 0;
+    } else if (what == source::stdin_pipe) {
+      static_cast<void>(on_stdin(i, events[e].events));
+    } else {
+      result.bytes_read += on_output(i, what);
+    }
+  }
+  return result;
+}
+
+bool process_group::on_exit(index_t const i, bool const block) {
+  siginfo_t status{};
+  int const options{WEXITED | (block ? 0 : WNOHANG)};
+  int ret;
+  do {
+    ret = waitid(P_PID, t.pids[i], &status, options);
+  } while ((ret == -1) && (current_errno() == EINTR));
+  EXEC_PATH_ARGS_SYSCALL_HELPER(ret);
+
+  if (status.si_pid == 0) {
+    return false; // not yet
+  }
+
+  t.finished_ns[i] = now_ns();
+  t.states[i] = state::finished;
+  t.return_codes[i] = status.si_status;
+  if ((t.flags[i] & kill_requested) && (status.si_code != CLD_EXITED) &&
+      (status.si_status == SIGKILL)) {
+    t.reasons[i] = exit_reason::killed;
+  } else if (t.flags[i] & timed_out) {
+    t.reasons[i] = (t.flags[i] & inactive) ? exit_reason::inactive
+                                           : exit_reason::timed_out;
+  } else {
+    t.reasons[i] = classify_exit(status, t.flags[i] & cpu_limited);
+  }
+  --num_running;
+  if (auto *const stats{stats_of(i)}) {
+    stats->runtime_ns.record(t.finished_ns[i] - t.spawned_ns[i]);
+  }
+  cancel_timer(i, timer_kind::deadline);
+  cancel_timer(i, timer_kind::inactivity);
+  cancel_timer(i, timer_kind::sampling);
+  if (auto const it{sampled.find(i)}; it != sampled.end()) {
+    close_fd(it->second.statm_fd);
+    close_fd(it->second.schedstat_fd);
+  }
+  // (no output counts as activity anymore)
+  inactivity.erase(i);
+  t.flags[i] &= static_cast<std::uint8_t>(~inactivity_set);
+
+  unwatch(t.pid_fds[i]);
+  end_stdin(i); // nobody reads it anymore
+
+  return true;
+}
+
+std::size_t process_group::on_output(index_t const i, source const what) {
+  auto &fd{what == source::stdout_pipe ? t.stdout_fds[i] : t.stderr_fds[i]};
+  auto &buffer{what == source::stdout_pipe ? t.stdout_buffers[i]
+                                           : t.stderr_buffers[i]};
+
+  // `epoll` reported it readable, so this doesn't block
+  char chunk[64 * 1024];
+  ssize_t nbytes;
+  do {
+    nbytes = read(fd, chunk, sizeof(chunk));
+  } while ((nbytes == -1) && (current_errno() == EINTR));
+  EXEC_PATH_ARGS_SYSCALL_HELPER(nbytes);
+
+  if (nbytes == 0) { // EOF
+    unwatch(fd);
+    return 0;
+  }
+  buffer.append(chunk, static_cast<std::size_t>(nbytes));
+  if (t.flags[i] & inactivity_set) {
+    inactivity.at(i).last_output_ns = now_ns();
+  }
+  if (!(t.flags[i] & got_output)) {
+    t.flags[i] |= got_output;
+    if (auto *const stats{stats_of(i)}) {
+      stats->first_output_ns.record(now_ns() - t.spawned_ns[i]);
+    }
+  }
+  return static_cast<std::size_t>(nbytes);
+}
+
+std::size_t process_group::on_stdin(index_t const i,
+                                    std::uint32_t const events) {
+  // (its stdin may have been closed by an earlier event of the same batch,
+  // e.g. the child's exit)
+  auto const feed{stdin_feeds.find(i)};
+  if ((t.stdin_fds[i] == invalid_fd) || (feed == stdin_feeds.end())) {
+    return 0;
+  } else if (events & EPOLLERR) { // the child closed its end
+    end_stdin(i);
+    return 0;
+  }
+
+  sigpipe_guard const guard;
+  bool reader_gone{false};
+  // (both gone once `end_stdin` is called)
+  auto &[producer, pending]{feed->second};
+  std::size_t written{0};
+  if (!pending.empty()) {
+    std::string_view const rest{pending};
+    written = write_pieces(t.stdin_fds[i], &rest, 1, false, &reader_gone);
+    pending.erase(0, written);
+    if (reader_gone) {
+      end_stdin(i);
+      return written;
+    } else if (!pending.empty()) {
+      return written;
+    }
+  }
+
+  // bounded, so a fast producer (& child) can't keep the others waiting
+  static int constexpr max_rounds{4};
+  char chunk[64 * 1024];
+  for (int round{0}; round < max_rounds; ++round) {
+    auto const size{
+        std::min(producer(chunk, sizeof(chunk)), sizeof(chunk))};
+    if (size == 0) {
+      end_stdin(i);
+      break;
+    }
+    std::string_view const data{chunk, size};
+    auto const n{
+        write_pieces(t.stdin_fds[i], &data, 1, false, &reader_gone)};
+    written += n;
+    if (reader_gone) { // (treated as the end of the stream)
+      end_stdin(i);
+      break;
+    } else if (n < size) {
+      pending.assign(chunk + n, size - n); // (the pipe is full)
+      break;
+    }
+  }
+  return written;
+}
+
+void process_group::end_stdin(index_t const i) noexcept {
+  if (auto const feed{stdin_feeds.find(i)}; feed != stdin_feeds.end()) {
+    if (t.stdin_fds[i] != invalid_fd) {
+      unwatch(t.stdin_fds[i]);
+    }
+    stdin_feeds.erase(feed);
+  }
+  close_fd(t.stdin_fds[i]);
+}
+
+} // namespace exec_path_args::os_wrapper
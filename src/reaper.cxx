@@ -0,0 +1,108 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "impl/reaper.hxx"
+
+#include <sys/epoll.h>
+#include <sys/wait.h>
+
+#include <cerrno>
+#include <cstdint>
+
+#include <thread>
+
+#include "impl/syscall_helper.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+namespace {
+
+void reap(process_handle_t const pid) noexcept {
+  siginfo_t status{};
+  while ((waitid(P_PID, pid, &status, WEXITED) == -1) &&
+         (current_errno() == EINTR)) {
+  }
+}
+
+[[nodiscard]] std::uint64_t pack(process_handle_t const pid,
+                                 native_fd_t const pid_fd) noexcept {
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pid)) << 32) |
+         static_cast<std::uint32_t>(pid_fd);
+}
+
+} // namespace
+
+reaper &reaper::instance() {
+  // intentionally leaked, see the header
+  static reaper *const the_reaper{new reaper};
+  return *the_reaper;
+}
+
+void reaper::adopt_or_reap(process_handle_t const pid,
+                           native_fd_t pid_fd) noexcept {
+  reaper *the_reaper{nullptr};
+  try {
+    the_reaper = &instance();
+  } catch (...) {
+    // (e.g. out of fds or threads - retried by the next call)
+    reap(pid);
+    close_fd(pid_fd);
+    return;
+  }
+  the_reaper->adopt(pid, pid_fd);
+}
+
+reaper::reaper()
+    : epoll_fd{EXEC_PATH_ARGS_SYSCALL_HELPER(epoll_create1(EPOLL_CLOEXEC))} {
+  std::thread{&reaper::run, this}.detach();
+}
+
+void reaper::adopt(process_handle_t const pid, native_fd_t pid_fd) noexcept {
+  num_pending.fetch_add(1, std::memory_order_relaxed);
+
+  // pidfd becomes readable once the process terminates
+  epoll_event ev{};
+  ev.events = EPOLLIN | EPOLLONESHOT;
+  ev.data.u64 = pack(pid, pid_fd);
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pid_fd, &ev) == -1) {
+    reap(pid);
+    close_fd(pid_fd);
+    num_pending.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void reaper::run() noexcept {
+  static int constexpr max_events{64};
+  epoll_event events[max_events];
+
+  while (true) {
+    int const n{epoll_wait(epoll_fd, events, max_events, -1)};
+    for (int i{0}; i < n; ++i) {
+      auto const data{events[i].data.u64};
+      auto const pid{static_cast<process_handle_t>(data >> 32)};
+      auto pid_fd{static_cast<native_fd_t>(data & 0xffff'ffffu)};
+
+      reap(pid);        // already terminated -> doesn't block
+      close_fd(pid_fd); // (removes it from the epoll set too)
+      num_pending.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+} // namespace exec_path_args::os_wrapper
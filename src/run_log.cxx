@@ -0,0 +1,308 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/run_log.hxx"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <stdexcept>
+#include <utility>
+
+#include "impl/syscall_helper.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+namespace {
+
+struct file_header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t record_size;
+};
+static_assert(sizeof(file_header) % alignof(run_record) == 0);
+
+file_header constexpr expected_header{{'E', 'P', 'A', 'R', 'U', 'N', 'L', 'G'},
+                                      1,
+                                      sizeof(run_record)};
+
+[[nodiscard]] bool is_expected(file_header const &header) noexcept {
+  return (std::memcmp(header.magic, expected_header.magic,
+                      sizeof(header.magic)) == 0) &&
+         (header.version == expected_header.version) &&
+         (header.record_size == expected_header.record_size);
+}
+
+[[nodiscard]] std::string strings_path_of(std::string const &path) {
+  return path + ".strings";
+}
+
+[[nodiscard]] std::size_t size_of(native_fd_t const fd) {
+  struct stat st {};
+  EXEC_PATH_ARGS_SYSCALL_HELPER(fstat(fd, &st));
+  return static_cast<std::size_t>(st.st_size);
+}
+
+void write_all(native_fd_t const fd, std::string_view data) {
+  while (!data.empty()) {
+    auto const written{write(fd, data.data(), data.size())};
+    if ((written == -1) && (current_errno() == EINTR)) {
+      continue;
+    }
+    EXEC_PATH_ARGS_SYSCALL_HELPER(written);
+    data.remove_prefix(static_cast<std::size_t>(written));
+  }
+}
+
+[[nodiscard]] void *map_whole(native_fd_t const fd, std::size_t const size) {
+  // https://man7.org/linux/man-pages/man2/mmap.2.html
+  auto *const p{mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)};
+  if (p == MAP_FAILED) {
+    throw std::runtime_error{"cannot map run log - " +
+                             std::string{std::strerror(current_errno())} +
+                             "!"};
+  }
+  return p;
+}
+
+} // namespace
+
+run_log_writer::run_log_writer(std::string const &path,
+                               std::size_t const a_buffer_bytes)
+    : buffer_bytes{a_buffer_bytes} {
+  try {
+    records_fd = EXEC_PATH_ARGS_SYSCALL_HELPER(
+        open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644));
+    strings_fd = EXEC_PATH_ARGS_SYSCALL_HELPER(
+        open(strings_path_of(path).c_str(),
+             O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644));
+
+    auto const records_size{size_of(records_fd)};
+    if (records_size == 0) {
+      write_all(records_fd,
+                {reinterpret_cast<char const *>(&expected_header),
+                 sizeof(expected_header)});
+    } else {
+      file_header header{};
+      if ((records_size < sizeof(header)) ||
+          (pread(records_fd, &header, sizeof(header), 0) !=
+           static_cast<ssize_t>(sizeof(header))) ||
+          !is_expected(header)) {
+        throw std::runtime_error{
+            "cannot append to run log - it isn't one (or of another version)!"};
+      }
+      // a partial record left by an interrupted write would misalign all the
+      // following ones
+      auto const whole_records{(records_size - sizeof(header)) /
+                               sizeof(run_record)};
+      EXEC_PATH_ARGS_SYSCALL_HELPER(ftruncate(
+          records_fd, static_cast<off_t>(sizeof(header) +
+                                         whole_records * sizeof(run_record))));
+    }
+    strings_size = size_of(strings_fd);
+  } catch (...) {
+    close_fd(records_fd);
+    close_fd(strings_fd);
+    throw;
+  }
+
+  writer = std::thread{&run_log_writer::write_in_background, this};
+}
+
+run_log_writer::~run_log_writer() noexcept {
+  try {
+    flush();
+  } catch (...) {
+    // nobody to report it to
+  }
+  {
+    std::lock_guard lck{mtx};
+    stopping = true;
+  }
+  work_available.notify_one();
+  writer.join();
+  close_fd(records_fd);
+  close_fd(strings_fd);
+}
+
+void run_log_writer::append(std::string_view const path,
+                            std::vector<std::string> const &args,
+                            run_record record) {
+  std::string command{path};
+  command.push_back('\0');
+  for (auto const &arg : args) {
+    command += arg;
+    command.push_back('\0');
+  }
+
+  std::unique_lock lck{mtx};
+  rethrow_any_error();
+
+  auto const [it, inserted]{command_offsets.try_emplace(command, 0)};
+  if (inserted) {
+    it->second = strings_size;
+    strings_size += command.size();
+    filling.strings += command;
+  }
+  record.command_offset = it->second;
+  record.command_size = static_cast<std::uint32_t>(command.size());
+  filling.records.append(reinterpret_cast<char const *>(&record),
+                         sizeof(record));
+
+  if (buffer_bytes <= filling.records.size() + filling.strings.size()) {
+    hand_over(lck);
+  }
+}
+
+void run_log_writer::flush() {
+  std::unique_lock lck{mtx};
+  if (!filling.records.empty() || !filling.strings.empty()) {
+    hand_over(lck);
+  }
+  work_done.wait(lck, [this] { return !writing_pending; });
+  rethrow_any_error();
+}
+
+void run_log_writer::hand_over(std::unique_lock<std::mutex> &lck) {
+  // (only a single chunk is written at a time - this waits if the writer
+  // lags behind)
+  work_done.wait(lck, [this] { return !writing_pending; });
+  std::swap(filling, writing);
+  writing_pending = true;
+  work_available.notify_one();
+}
+
+void run_log_writer::rethrow_any_error() const {
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void run_log_writer::write_in_background() noexcept {
+  std::unique_lock lck{mtx};
+  while (true) {
+    work_available.wait(lck, [this] { return stopping || writing_pending; });
+    if (!writing_pending) {
+      return; // stopping & nothing left
+    }
+
+    lck.unlock();
+    std::exception_ptr failure;
+    try {
+      // strings first - a record never points past the string table
+      write_all(strings_fd, writing.strings);
+      write_all(records_fd, writing.records);
+    } catch (...) {
+      failure = std::current_exception();
+    }
+    writing.strings.clear();
+    writing.records.clear();
+    lck.lock();
+
+    if (failure && !error) {
+      error = failure;
+    }
+    writing_pending = false;
+    work_done.notify_all();
+  }
+}
+
+run_log_reader::run_log_reader(std::string const &path) {
+  native_fd_t records_fd{invalid_fd};
+  native_fd_t strings_fd{invalid_fd};
+  try {
+    records_fd = EXEC_PATH_ARGS_SYSCALL_HELPER(
+        open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    strings_fd = EXEC_PATH_ARGS_SYSCALL_HELPER(
+        open(strings_path_of(path).c_str(), O_RDONLY | O_CLOEXEC));
+
+    records_map_size = size_of(records_fd);
+    if (records_map_size < sizeof(file_header)) {
+      throw std::runtime_error{"cannot read run log - it isn't one!"};
+    }
+    records_map = map_whole(records_fd, records_map_size);
+    if (!is_expected(*static_cast<file_header const *>(records_map))) {
+      throw std::runtime_error{
+          "cannot read run log - it isn't one (or of another version)!"};
+    }
+    records = reinterpret_cast<run_record const *>(
+        static_cast<char const *>(records_map) + sizeof(file_header));
+    num_records =
+        (records_map_size - sizeof(file_header)) / sizeof(run_record);
+
+    strings_map_size = size_of(strings_fd);
+    if (strings_map_size > 0) { // (`mmap` refuses an empty mapping)
+      strings_map = map_whole(strings_fd, strings_map_size);
+    }
+  } catch (...) {
+    close_fd(records_fd);
+    close_fd(strings_fd);
+    unmap();
+    throw;
+  }
+  // (the mappings stay valid without them)
+  close_fd(records_fd);
+  close_fd(strings_fd);
+}
+
+run_log_reader::~run_log_reader() noexcept { unmap(); }
+
+void run_log_reader::unmap() noexcept {
+  if (records_map != nullptr) {
+    munmap(records_map, records_map_size);
+    records_map = nullptr;
+  }
+  if (strings_map != nullptr) {
+    munmap(strings_map, strings_map_size);
+    strings_map = nullptr;
+  }
+}
+
+std::string_view
+run_log_reader::command_of(run_record const &record) const {
+  if ((strings_map_size < record.command_offset) ||
+      (strings_map_size - record.command_offset < record.command_size)) {
+    throw std::runtime_error{
+        "cannot read command - it's outside of the string table!"};
+  }
+  return {static_cast<char const *>(strings_map) + record.command_offset,
+          record.command_size};
+}
+
+std::vector<std::string_view>
+run_log_reader::command_parts_of(run_record const &record) const {
+  auto command{command_of(record)};
+  std::vector<std::string_view> parts;
+  while (!command.empty()) {
+    auto const end{command.find('\0')};
+    parts.push_back(command.substr(0, end));
+    if (end == std::string_view::npos) {
+      break;
+    }
+    command.remove_prefix(end + 1);
+  }
+  return parts;
+}
+
+} // namespace exec_path_args::os_wrapper
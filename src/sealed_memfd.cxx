@@ -0,0 +1,54 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/sealed_memfd.hxx"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "impl/syscall_helper.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+native_fd_t sealed_memfd(std::string_view const data, char const *const name) {
+  native_fd_t fd{EXEC_PATH_ARGS_SYSCALL_HELPER(
+      memfd_create(name, MFD_CLOEXEC | MFD_ALLOW_SEALING))};
+  try {
+    // sized up front, so the kernel doesn't keep growing it while writing
+    EXEC_PATH_ARGS_SYSCALL_HELPER(
+        ftruncate(fd, static_cast<off_t>(data.size())));
+    std::size_t written{0};
+    while (written < data.size()) {
+      written += static_cast<std::size_t>(EXEC_PATH_ARGS_SYSCALL_HELPER(
+          pwrite(fd, data.data() + written, data.size() - written,
+                 static_cast<off_t>(written))));
+    }
+    // https://man7.org/linux/man-pages/man2/fcntl.2.html (File Sealing)
+    EXEC_PATH_ARGS_SYSCALL_HELPER(
+        fcntl(fd, F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL));
+  } catch (...) {
+    close_fd(fd);
+    throw;
+  }
+  return fd;
+}
+
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,117 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/spawn_batch.hxx"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include "impl/argv_arena.hxx"
+#include "impl/child_setup.hxx"
+
+namespace exec_path_args::os_wrapper {
+
+std::vector<std::exception_ptr> spawn_batch(exec_path_args *const cmds,
+                                            std::size_t const count,
+                                            int const num_threads) {
+  std::vector<std::exception_ptr> results(count);
+
+  auto const spawn_chunk = [cmds, &results](std::size_t const first,
+                                            std::size_t const last) {
+    std::vector<std::optional<pending_spawn>> pendings(last - first);
+
+    auto const failed = [&](std::size_t const i) {
+      results[i] = std::current_exception();
+      pendings[i - first].reset();
+      cmds[i].reset_pipes();
+    };
+
+    // 1. prepare everything
+    std::size_t total_words{0};
+    for (auto i{first}; i < last; ++i) {
+      auto &cmd{cmds[i]};
+      if (cmd.current_state != exec_path_args::state::ready) {
+        results[i] = std::make_exception_ptr(
+            std::runtime_error{"cannot spawn - process isn't ready!"});
+        continue;
+      }
+      try {
+        auto const &inputs{*cmd.inputs};
+        cmd.prepare_spawn(pendings[i - first].emplace(inputs.options));
+        total_words += argv_arena::words_needed(inputs.path, inputs.args);
+      } catch (...) {
+        failed(i);
+      }
+    }
+
+    argv_arena arena{total_words};
+    std::vector<char **> argvs(last - first);
+    for (auto i{first}; i < last; ++i) {
+      if (pendings[i - first].has_value()) {
+        auto const &inputs{*cmds[i].inputs};
+        argvs[i - first] = arena.emplace(inputs.path, inputs.args);
+      }
+    }
+
+    // 2. `fork` them all
+    for (auto i{first}; i < last; ++i) {
+      if (auto &pending{pendings[i - first]}; pending.has_value()) {
+        try {
+          cmds[i].launch(*pending, argvs[i - first]);
+        } catch (...) {
+          failed(i);
+        }
+      }
+    }
+
+    // 3. wait for their `execv`s
+    for (auto i{first}; i < last; ++i) {
+      if (auto &pending{pendings[i - first]}; pending.has_value()) {
+        try {
+          cmds[i].complete_spawn(*pending);
+        } catch (...) {
+          results[i] = std::current_exception();
+        }
+      }
+    }
+  };
+
+  auto const threads{
+      std::min(static_cast<std::size_t>(std::max(num_threads, 1)),
+               std::max<std::size_t>(count, 1))};
+  if (threads == 1) {
+    spawn_chunk(0, count);
+  } else {
+    std::vector<std::thread> spawners;
+    spawners.reserve(threads);
+    auto const chunk{(count + threads - 1) / threads};
+    for (std::size_t first{0}; first < count; first += chunk) {
+      spawners.emplace_back(spawn_chunk, first, std::min(first + chunk, count));
+    }
+    for (auto &spawner : spawners) {
+      spawner.join();
+    }
+  }
+
+  return results;
+}
+
+} // namespace exec_path_args::os_wrapper
@@ -19,9 +19,12 @@
 
 #include "impl/syscall_helper.hxx"
 
+#include <unistd.h>
+
 #include <cerrno>
 #include <cstring>
 
+#include <iostream>
 #include <stdexcept>
 #include <string>
 
@@ -43,4 +46,30 @@ void check_syscall_ret_val(std::string_view const file, int const line,
   }
 };
 
+void close_fd(native_fd_t &fd) noexcept {
+  if (fd != invalid_fd) {
+    // https://linux.die.net/man/2/close
+    if (close(fd) == -1) {
+      auto const errno_val{current_errno()};
+      switch (errno_val) {
+      case EBADF:
+        std::cerr << "`close` failed - invalid file descriptor!\n";
+        break;
+      case EINTR:
+        std::cerr << "`close` failed - was interrupted by a signal!\n";
+        break;
+      case EIO:
+        std::cerr << "`close` failed - I/O error occurred!\n";
+        break;
+      default:
+        std::cerr << "`close` failed - by https://linux.die.net/man/2/close "
+                     "unspecified `errno` "
+                  << errno_val << "!\n";
+        break;
+      }
+    }
+    fd = invalid_fd;
+  }
+}
+
 } // namespace exec_path_args::os_wrapper
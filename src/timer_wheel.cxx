@@ -0,0 +1,139 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "impl/timer_wheel.hxx"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace exec_path_args::os_wrapper {
+
+timer_wheel::timer_wheel() noexcept {
+  std::fill(std::begin(heads), std::end(heads), nil);
+}
+
+void timer_wheel::arm(timer_id const id, tick_t const expiry) {
+  if (id == nil) {
+    throw std::runtime_error{"cannot arm timer - invalid id!"};
+  }
+  if (expiries.size() <= id) {
+    auto const new_size{std::max<std::size_t>(id + 1, 2 * expiries.size())};
+    expiries.resize(new_size, 0);
+    next.resize(new_size, nil);
+    prev.resize(new_size, nil);
+    slot_of.resize(new_size, nil);
+  }
+
+  cancel(id);
+  expiries[id] = std::max(expiry, current + 1);
+  insert(id);
+}
+
+void timer_wheel::cancel(timer_id const id) noexcept {
+  if (!armed(id)) {
+    return;
+  }
+
+  auto const slot{slot_of[id]};
+  if (prev[id] != nil) {
+    next[prev[id]] = next[id];
+  } else {
+    heads[slot] = next[id];
+  }
+  if (next[id] != nil) {
+    prev[next[id]] = prev[id];
+  }
+  next[id] = prev[id] = slot_of[id] = nil;
+
+  --per_level[slot / slots_per_level];
+  --num_armed;
+}
+
+timer_wheel::tick_t timer_wheel::ticks_until_next() const noexcept {
+  if (num_armed == 0) {
+    return -1;
+  }
+
+  // nothing on a level can move before the next "rollover" of the levels
+  // below it:
+  tick_t result{horizon};
+  for (int level{1}; level < levels; ++level) {
+    if (per_level[level] != 0) {
+      auto const span{tick_t{1} << (bits_per_level * level)};
+      result = ((current / span) + 1) * span - current;
+      break;
+    }
+  }
+
+  if (per_level[0] != 0) {
+    for (tick_t k{1}; k < std::min<tick_t>(result, slots_per_level + 1); ++k) {
+      if (heads[slot_index(0, current + k)] != nil) {
+        return k;
+      }
+    }
+  }
+  return result;
+}
+
+void timer_wheel::insert(timer_id const id) {
+  auto const expiry{expiries[id]};
+  auto const delta{std::min(expiry - current, horizon - 1)};
+
+  int level{0};
+  while ((tick_t{1} << (bits_per_level * (level + 1))) <= delta) {
+    ++level;
+  }
+  auto const slot{slot_index(level, current + delta)};
+
+  next[id] = heads[slot];
+  prev[id] = nil;
+  if (heads[slot] != nil) {
+    prev[heads[slot]] = id;
+  }
+  heads[slot] = id;
+  slot_of[id] = slot;
+
+  ++per_level[level];
+  ++num_armed;
+}
+
+void timer_wheel::cascade() {
+  for (int level{levels - 1}; 0 < level; --level) {
+    auto const span{tick_t{1} << (bits_per_level * level)};
+    if ((current % span) != 0) {
+      continue;
+    }
+    auto const slot{slot_index(level, current)};
+    while (heads[slot] != nil) {
+      auto const id{heads[slot]};
+      cancel(id);
+      insert(id); // (`expiries[id]` unchanged)
+    }
+  }
+}
+
+timer_wheel::tick_t timer_wheel::skip_idle(tick_t const to) const noexcept {
+  auto const until_next{ticks_until_next()};
+  if (until_next < 0) {
+    return to;
+  }
+  return std::min(to, current + until_next - 1);
+}
+
+} // namespace exec_path_args::os_wrapper
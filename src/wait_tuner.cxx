@@ -0,0 +1,95 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/wait_tuner.hxx"
+
+#include <unistd.h>
+
+#include <algorithm>
+
+namespace exec_path_args::os_wrapper {
+
+long long wait_tuner::default_max_spin_ns() {
+  static long long const result{(sysconf(_SC_NPROCESSORS_ONLN) > 1) ? 200'000
+                                                                    : 0};
+  return result;
+}
+
+wait_tuner::wait_tuner(long long const max_spin_ns,
+                       std::size_t const max_templates)
+    : max_spin_ns{max_spin_ns}, max_templates{max_templates} {}
+
+wait_tuner::template_id
+wait_tuner::template_of(std::string const &path,
+                        std::vector<std::string> const &args) {
+  // FNV-1a, see http://www.isthe.com/chongo/tech/comp/fnv/
+  template_id hash{14695981039346656037ull};
+  auto const add = [&hash](char const c) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  };
+
+  for (auto const c : path) {
+    add(c);
+  }
+  for (auto const &arg : args) {
+    add('\0');
+    for (auto const c : arg) {
+      if ((c < '0') || ('9' < c)) {
+        add(c);
+      }
+    }
+  }
+  return hash;
+}
+
+long long wait_tuner::spin_budget_ns(template_id const id) const {
+  if (max_spin_ns <= 0) {
+    return 0;
+  }
+
+  long long typical;
+  {
+    std::lock_guard const lock{mtx};
+    auto const it{typical_ns.find(id)};
+    if (it == typical_ns.end()) {
+      return 0; // nothing known yet
+    }
+    typical = it->second;
+  }
+  // with some slack, as the durations vary
+  return (typical <= max_spin_ns) ? std::min(2 * typical, max_spin_ns) : 0;
+}
+
+void wait_tuner::record(template_id const id, long long const duration_ns) {
+  std::lock_guard const lock{mtx};
+  auto it{typical_ns.find(id)};
+  if (it == typical_ns.end()) {
+    if (max_templates <= typical_ns.size()) {
+      return;
+    }
+    typical_ns.emplace(id, duration_ns);
+    return;
+  }
+  // weight 1/4 - follows changes within a few runs, but isn't thrown off by a
+  // single outlier
+  it->second += (duration_ns - it->second) / 4;
+}
+
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,99 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <time.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// minimalistic, self-contained benchmarking "framework" - each benchmark
+// reports any number of named metrics, which are printed (as CSV or JSON) once
+// all of them finish; see `benchmark_main.cxx` for the command line options
+namespace exec_path_args::bench {
+
+[[nodiscard]] inline long long now_ns() {
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return static_cast<long long>(t.tv_sec) * 1'000'000'000 + t.tv_nsec;
+}
+
+// `p` in [0, 100]; sorts `samples`
+[[nodiscard]] inline double percentile(std::vector<double> &samples,
+                                       double const p) {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  std::sort(samples.begin(), samples.end());
+  auto const idx{static_cast<std::size_t>(
+      p / 100.0 * static_cast<double>(samples.size() - 1) + 0.5)};
+  return samples[std::min(idx, samples.size() - 1)];
+}
+
+struct context {
+  struct result {
+    std::string benchmark;
+    std::string metric;
+    double value;
+    std::string unit;
+  };
+
+  // (the CSV output isn't quoted - so neither `metric` nor `unit` may contain
+  // a `,` or a line break)
+  void report(std::string_view const metric, double const value,
+              std::string_view const unit) {
+    if ((metric.find_first_of(",\n") != std::string_view::npos) ||
+        (unit.find_first_of(",\n") != std::string_view::npos)) {
+      throw std::runtime_error{"cannot report `" + std::string{metric} +
+                               "` - its name or unit contains `,` or a "
+                               "line break!"};
+    }
+    results.push_back(result{current_benchmark, std::string{metric}, value,
+                             std::string{unit}});
+  }
+
+  // workload sizes should go through this, so `--quick` can shrink them
+  [[nodiscard]] int scaled(int const full) const {
+    return std::max(1, full / scale_down);
+  }
+
+  std::string some_cli_app{EXECPATHARGS_SOME_CLI_APP};
+  int scale_down{1};
+  std::string current_benchmark;
+  std::vector<result> results;
+};
+
+using benchmark_fn = void (*)(context &ctx);
+
+struct benchmark_registrar {
+  benchmark_registrar(char const *const name, benchmark_fn const fn);
+};
+
+} // namespace exec_path_args::bench
+
+#define EXEC_PATH_ARGS_BENCHMARK(name)                                         \
+  static void name(::exec_path_args::bench::context &ctx);                     \
+  static ::exec_path_args::bench::benchmark_registrar const                    \
+      name##_registrar{#name, name};                                           \
+  static void name(::exec_path_args::bench::context &ctx)
@@ -0,0 +1,191 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "bench.hxx"
+
+#include <sys/resource.h>
+
+#include <cstdlib>
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace exec_path_args::bench {
+
+namespace {
+
+[[nodiscard]] std::vector<std::pair<char const *, benchmark_fn>> &registry() {
+  static std::vector<std::pair<char const *, benchmark_fn>> benchmarks;
+  return benchmarks;
+}
+
+void print_csv(std::ostream &os, std::vector<context::result> const &results) {
+  os << "benchmark,metric,value,unit\n";
+  for (auto const &r : results) {
+    os << r.benchmark << ',' << r.metric << ',' << r.value << ',' << r.unit
+       << '\n';
+  }
+}
+
+void print_json(std::ostream &os,
+                std::vector<context::result> const &results) {
+  os << "[\n";
+  for (std::size_t i{0}; i < results.size(); ++i) {
+    auto const &r{results[i]};
+    os << "  {\"benchmark\": \"" << r.benchmark << "\", \"metric\": \""
+       << r.metric << "\", \"value\": " << r.value << ", \"unit\": \""
+       << r.unit << "\"}" << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  os << "]\n";
+}
+
+// `benchmark,metric` -> `value`, from a previous run's CSV output
+[[nodiscard]] std::map<std::string, double>
+read_baseline(std::string const &path) {
+  std::ifstream file{path};
+  if (!file) {
+    throw std::runtime_error{"cannot open baseline " + path};
+  }
+  std::map<std::string, double> baseline;
+  std::string line;
+  std::getline(file, line); // header
+  while (std::getline(file, line)) {
+    std::istringstream fields{line};
+    std::string benchmark;
+    std::string metric;
+    std::string value;
+    if (std::getline(fields, benchmark, ',') &&
+        std::getline(fields, metric, ',') && std::getline(fields, value, ',')) {
+      baseline[benchmark + ',' + metric] = std::stod(value);
+    }
+  }
+  return baseline;
+}
+
+// rates (units ending in "/s") should go up, anything else (latencies, sizes)
+// down; returns how many metrics got worse by more than `threshold_percent`
+[[nodiscard]] int
+report_regressions(std::map<std::string, double> const &baseline,
+                   std::vector<context::result> const &results,
+                   double const threshold_percent) {
+  int regressions{0};
+  for (auto const &r : results) {
+    auto const it{baseline.find(r.benchmark + ',' + r.metric)};
+    if ((it == baseline.end()) || (it->second == 0.0)) {
+      continue;
+    }
+    bool const higher_is_better{(2 <= r.unit.size()) &&
+                                (r.unit.compare(r.unit.size() - 2, 2,
+                                                "/s") == 0)};
+    auto const change_percent{(r.value - it->second) / it->second * 100};
+    if ((higher_is_better ? -change_percent : change_percent) >
+        threshold_percent) {
+      std::cerr << "REGRESSION " << r.benchmark << ',' << r.metric << ": "
+                << it->second << " -> " << r.value << ' ' << r.unit << " ("
+                << (change_percent > 0 ? "+" : "") << change_percent
+                << "%)\n";
+      ++regressions;
+    }
+  }
+  return regressions;
+}
+
+} // namespace
+
+benchmark_registrar::benchmark_registrar(char const *const name,
+                                         benchmark_fn const fn) {
+  registry().emplace_back(name, fn);
+}
+
+} // namespace exec_path_args::bench
+
+int main(int const argc, char const **argv) try {
+  using namespace exec_path_args::bench;
+
+  bool json{false};
+  bool list_only{false};
+  std::string filter;
+  std::string baseline_path;
+  double threshold_percent{20};
+  context ctx;
+
+  for (int i{1}; i < argc; ++i) {
+    std::string_view const arg{argv[i]};
+    if (arg == "--json") {
+      json = true;
+    } else if (arg == "--quick") {
+      ctx.scale_down = 10;
+    } else if (arg == "--list") {
+      list_only = true;
+    } else if ((arg == "--filter") && (i + 1 < argc)) {
+      filter = argv[++i];
+    } else if ((arg == "--baseline") && (i + 1 < argc)) {
+      baseline_path = argv[++i];
+    } else if ((arg == "--threshold") && (i + 1 < argc)) {
+      threshold_percent = std::stod(argv[++i]);
+    } else {
+      throw std::runtime_error{
+          std::string{"Unknown argument: "} + std::string{arg} +
+          " (supported: --json, --quick, --list, --filter <substring>, "
+          "--baseline <previous CSV output>, --threshold <percent>)"};
+    }
+  }
+
+  // many children (each with several pipes) alive at once:
+  if (rlimit lim; getrlimit(RLIMIT_NOFILE, &lim) == 0) {
+    lim.rlim_cur = lim.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &lim);
+  }
+
+  for (auto const &[name, fn] : registry()) {
+    if (std::string_view{name}.find(filter) == std::string_view::npos) {
+      continue;
+    } else if (list_only) {
+      std::cout << name << '\n';
+      continue;
+    }
+    std::cerr << "running " << name << " ...\n";
+    ctx.current_benchmark = name;
+    fn(ctx);
+  }
+
+  if (list_only) {
+    return EXIT_SUCCESS;
+  }
+  json ? print_json(std::cout, ctx.results)
+       : print_csv(std::cout, ctx.results);
+
+  // a regression guard - e.g. for CI
+  if (!baseline_path.empty() &&
+      (report_regressions(read_baseline(baseline_path), ctx.results,
+                          threshold_percent) != 0)) {
+    return 2;
+  }
+  return EXIT_SUCCESS;
+} catch (std::exception const &e) {
+  std::cerr << "exec_path_args_benchmarks caught `std::exception`: "
+            << e.what() << '\n';
+  return EXIT_FAILURE;
+}
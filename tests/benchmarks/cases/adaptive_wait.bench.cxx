@@ -0,0 +1,66 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/exec_path_args.hxx"
+#include "exec_path_args/wait_tuner.hxx"
+
+#include <string>
+#include <vector>
+
+#include "bench.hxx"
+
+namespace exec_path_args::bench {
+namespace {
+
+using os_wrapper::exec_path_args;
+
+// spawn & wait for a very short-lived child, over & over
+void measure_runs(context &ctx, std::string const &prefix, int const count,
+                  os_wrapper::wait_tuner *const tuner) {
+  std::vector<double> samples;
+  samples.reserve(count);
+  for (int i{0}; i < count; ++i) {
+    os_wrapper::spawn_options options;
+    options.wait_tuning = tuner;
+    exec_path_args cmd{"/bin/true", {}, std::move(options)};
+    auto const start{now_ns()};
+    cmd.finish();
+    samples.push_back(static_cast<double>(now_ns() - start) / 1000);
+  }
+  ctx.report(prefix + "_p50", percentile(samples, 50), "us/run");
+  ctx.report(prefix + "_p99", percentile(samples, 99), "us/run");
+}
+
+} // namespace
+
+// NOTE: with a single CPU, `wait_tuner` doesn't spin by default - "forced" is
+// there to show why
+EXEC_PATH_ARGS_BENCHMARK(adaptive_wait) {
+  int const count{ctx.scaled(1000)};
+
+  measure_runs(ctx, "poll", count, nullptr);
+
+  os_wrapper::wait_tuner tuner;
+  measure_runs(ctx, "adaptive", count, &tuner);
+
+  os_wrapper::wait_tuner forced{1'000'000};
+  measure_runs(ctx, "adaptive_forced", count, &forced);
+}
+
+} // namespace exec_path_args::bench
@@ -0,0 +1,200 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "exec_path_args/exec_path_args.hxx"
+#include "exec_path_args/process_group.hxx"
+#include "exec_path_args/spawn_batch.hxx"
+
+#include "bench.hxx"
+
+namespace exec_path_args::bench {
+namespace {
+
+using os_wrapper::exec_path_args;
+using os_wrapper::process_group;
+
+// anonymous memory of the benchmark process itself, all of it touched (so it's
+// resident & its page tables populated - which is what makes `fork` slow)
+struct ballast {
+  ballast(std::size_t const size, bool const huge_pages) : size{size} {
+    if (size == 0) {
+      return;
+    }
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+      throw std::runtime_error{"cannot allocate ballast!"};
+    }
+    // (only a hint - the kernel may still use normal pages)
+    madvise(memory, size, huge_pages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+
+    auto const page_size{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))};
+    auto *const bytes{static_cast<char *>(memory)};
+    for (std::size_t i{0}; i < size; i += page_size) {
+      bytes[i] = 1;
+    }
+  }
+
+  ~ballast() {
+    if (size != 0) {
+      munmap(memory, size);
+    }
+  }
+
+  ballast(ballast const &) = delete;
+  ballast &operator=(ballast const &) = delete;
+
+  std::size_t size;
+  void *memory{nullptr};
+};
+
+// threads that only wait to be stopped
+struct idle_threads {
+  explicit idle_threads(int const count) {
+    for (int i{0}; i < count; ++i) {
+      threads.emplace_back([this] {
+        std::unique_lock lock{mtx};
+        stop_requested.wait(lock, [this] { return stopping; });
+      });
+    }
+  }
+
+  ~idle_threads() {
+    {
+      std::lock_guard const lock{mtx};
+      stopping = true;
+    }
+    stop_requested.notify_all();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  std::mutex mtx;
+  std::condition_variable stop_requested;
+  bool stopping{false};
+  std::vector<std::thread> threads;
+};
+
+[[nodiscard]] std::size_t available_memory() {
+  std::ifstream meminfo{"/proc/meminfo"};
+  std::string key;
+  std::size_t kib;
+  std::string unit;
+  while (meminfo >> key >> kib >> unit) {
+    if (key == "MemAvailable:") {
+      return kib * 1024;
+    }
+  }
+  return 0;
+}
+
+// what `fork` costs - i.e. only spawning, the children are reaped outside of
+// the measurement
+void measure_backends(context &ctx, std::string const &prefix) {
+  int const count{ctx.scaled(200)};
+
+  std::vector<double> samples_us;
+  samples_us.reserve(count);
+  for (int i{0}; i < count; ++i) {
+    exec_path_args cmd{"/bin/true", {}};
+    auto const start{now_ns()};
+    static_cast<void>(cmd.update_and_get_state());
+    samples_us.push_back(static_cast<double>(now_ns() - start) / 1000);
+    cmd.finish();
+  }
+  ctx.report(prefix + "exec_path_args_p50", percentile(samples_us, 50), "us");
+  ctx.report(prefix + "exec_path_args_p99", percentile(samples_us, 99), "us");
+
+  {
+    std::vector<exec_path_args> cmds;
+    cmds.reserve(count);
+    for (int i{0}; i < count; ++i) {
+      cmds.emplace_back("/bin/true", std::vector<std::string>{});
+    }
+    auto const start{now_ns()};
+    static_cast<void>(os_wrapper::spawn_batch(cmds, 1));
+    ctx.report(prefix + "spawn_batch",
+               static_cast<double>(now_ns() - start) / 1000 / count,
+               "us/spawn");
+    for (auto &cmd : cmds) {
+      cmd.finish();
+    }
+  }
+
+  {
+    process_group group;
+    group.reserve(count);
+    for (int i{0}; i < count; ++i) {
+      static_cast<void>(group.add("/bin/true", {}));
+    }
+    auto const start{now_ns()};
+    static_cast<void>(group.spawn_all());
+    ctx.report(prefix + "process_group",
+               static_cast<double>(now_ns() - start) / 1000 / count,
+               "us/spawn");
+    group.finish_all();
+  }
+}
+
+} // namespace
+
+// spawn latency of every backend (all of them `fork`) as the parent's RSS
+// grows - with & without transparent huge pages (fewer page table entries to
+// copy) and with & without many (idle) threads; sizes that don't fit into the
+// available memory are skipped
+EXEC_PATH_ARGS_BENCHMARK(fork_vs_rss) {
+  static int constexpr many_threads{32};
+
+  measure_backends(ctx, "rss_0mb_");
+
+  for (std::size_t const mib : {100, 1024, 4096}) {
+    auto const size{(mib << 20) / static_cast<std::size_t>(ctx.scale_down)};
+    if (available_memory() * 3 / 4 < size) {
+      std::cerr << "  skipping " << (size >> 20)
+                << " MiB - not enough memory available\n";
+      continue;
+    }
+    for (bool const huge_pages : {false, true}) {
+      ballast const inflated{size, huge_pages};
+      for (int const num_threads : {0, many_threads}) {
+        idle_threads const threads{num_threads};
+        measure_backends(ctx, "rss_" + std::to_string(size >> 20) + "mb_" +
+                                  (huge_pages ? "thp_" : "nothp_") +
+                                  std::to_string(num_threads) + "threads_");
+      }
+    }
+  }
+}
+
+} // namespace exec_path_args::bench
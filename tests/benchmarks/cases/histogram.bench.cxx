@@ -0,0 +1,73 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/latency_histogram.hxx"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bench.hxx"
+
+namespace exec_path_args::bench {
+
+using os_wrapper::latency_histogram;
+
+// what recording costs (e.g. on every spawn/exit/first output of a
+// `process_group` with stats enabled), & querying/merging
+EXEC_PATH_ARGS_BENCHMARK(histogram) {
+  int const count{ctx.scaled(10'000'000)};
+
+  std::vector<long long> values(4096);
+  std::uint64_t lcg{3};
+  for (auto &value : values) {
+    lcg = lcg * 6364136223846793005ull + 1442695040888963407ull;
+    value = static_cast<long long>((lcg >> 24) % 100'000'000);
+  }
+
+  auto const h{std::make_unique<latency_histogram>()};
+  auto start{now_ns()};
+  for (int i{0}; i < count; ++i) {
+    h->record(values[static_cast<std::size_t>(i) % values.size()]);
+  }
+  ctx.report("record", static_cast<double>(now_ns() - start) / count,
+             "ns/value");
+
+  static int constexpr queries{10'000};
+  long long sink{0};
+  start = now_ns();
+  for (int i{0}; i < queries; ++i) {
+    sink += h->quantile(0.99);
+  }
+  ctx.report("quantile", static_cast<double>(now_ns() - start) / queries,
+             "ns/query");
+
+  auto const other{std::make_unique<latency_histogram>()};
+  start = now_ns();
+  for (int i{0}; i < queries; ++i) {
+    other->merge(*h);
+  }
+  ctx.report("merge", static_cast<double>(now_ns() - start) / queries,
+             "ns/merge");
+  if (sink == 42) {
+    ctx.report("(keeping the queries)", 0, "");
+  }
+}
+
+} // namespace exec_path_args::bench
@@ -0,0 +1,362 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "exec_path_args/exec_path_args.hxx"
+#include "exec_path_args/process_group.hxx"
+#include "exec_path_args/sealed_memfd.hxx"
+
+#include "bench.hxx"
+
+extern char **environ;
+
+namespace exec_path_args::bench {
+namespace {
+
+using os_wrapper::exec_path_args;
+using os_wrapper::process_group;
+
+// `some_cli_app --binary-echo` with both stdin & stdout being pipes (plain
+// `posix_spawn`)
+struct raw_echo {
+  explicit raw_echo(std::string const &some_cli_app) {
+    int in[2];
+    int out[2];
+    if ((pipe(in) != 0) || (pipe(out) != 0)) {
+      std::abort();
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, in[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, out[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, in[1]);
+    posix_spawn_file_actions_addclose(&actions, out[0]);
+    static char arg0[]{"some_cli_app"};
+    static char arg1[]{"--binary-echo"};
+    static char *const argv[]{arg0, arg1, nullptr};
+    if (posix_spawn(&pid, some_cli_app.c_str(), &actions, nullptr, argv,
+                    environ) != 0) {
+      std::abort();
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    close(in[0]);
+    close(out[1]);
+    to_child = in[1];
+    from_child = out[0];
+  }
+
+  ~raw_echo() {
+    close(to_child);
+    close(from_child);
+    int status;
+    waitpid(pid, &status, 0);
+  }
+
+  pid_t pid;
+  int to_child;
+  int from_child;
+};
+
+void report_latencies(context &ctx, std::string const &prefix,
+                      std::vector<double> &samples_us) {
+  ctx.report(prefix + "_p50", percentile(samples_us, 50), "us");
+  ctx.report(prefix + "_p99", percentile(samples_us, 99), "us");
+}
+
+} // namespace
+
+// capturing a large stdout (`some_cli_app --flood-stdout ...`); the baseline:
+// `popen` + `fread`
+EXEC_PATH_ARGS_BENCHMARK(stdout_bandwidth) {
+  long long const size{ctx.scaled(256) * 1024LL * 1024};
+  auto const size_arg{std::to_string(size)};
+  auto const report = [&ctx, size](char const *const metric,
+                                   long long const elapsed_ns) {
+    ctx.report(metric, static_cast<double>(size) * 1e9 / (1 << 20) /
+                           static_cast<double>(elapsed_ns),
+               "MiB/s");
+  };
+
+  // (`exec_path_args` can only be polled for output - here every millisecond,
+  // so it's bound by how much the pipe holds)
+  auto start{now_ns()};
+  {
+    exec_path_args cmd{std::string{ctx.some_cli_app},
+                       {"--flood-stdout", size_arg}};
+    std::size_t total{0};
+    while (!cmd.is_finished()) {
+      static_cast<void>(cmd.update_and_get_state(1));
+      total += cmd.get_stdout().size();
+    }
+    total += cmd.get_stdout().size();
+    if (total != static_cast<std::size_t>(size)) {
+      std::abort();
+    }
+  }
+  report("exec_path_args", now_ns() - start);
+
+  start = now_ns();
+  {
+    process_group group;
+    auto const i{group.add(std::string{ctx.some_cli_app},
+                           {"--flood-stdout", size_arg})};
+    static_cast<void>(group.spawn_all());
+    std::size_t total{0};
+    while (group.running() != 0) {
+      static_cast<void>(group.update_all(-1));
+      total += group.get_stdout(i).size();
+    }
+    static_cast<void>(group.collect_outputs());
+    total += group.get_stdout(i).size();
+    if (total != static_cast<std::size_t>(size)) {
+      std::abort();
+    }
+  }
+  report("process_group", now_ns() - start);
+
+  start = now_ns();
+  {
+    auto *const f{
+        popen((ctx.some_cli_app + " --flood-stdout " + size_arg).c_str(), "r")};
+    std::vector<char> buffer(64 * 1024);
+    std::size_t total{0};
+    std::size_t n;
+    while ((n = fread(buffer.data(), 1, buffer.size(), f)) != 0) {
+      total += n;
+    }
+    static_cast<void>(pclose(f));
+    if (total != static_cast<std::size_t>(size)) {
+      std::abort();
+    }
+  }
+  report("popen", now_ns() - start);
+}
+
+// a few bytes to `some_cli_app --binary-echo`, until they come back; the
+// baseline: blocking `write` & `read` on plain pipes
+EXEC_PATH_ARGS_BENCHMARK(stdin_round_trip) {
+  int const count{ctx.scaled(2000)};
+  static std::string const line{"ping\n"};
+  std::vector<double> samples_us;
+  samples_us.reserve(count);
+
+  // (`exec_path_args` can only be polled for output)
+  {
+    exec_path_args cmd{std::string{ctx.some_cli_app}, {"--binary-echo"}};
+    static_cast<void>(cmd.update_and_get_state());
+    for (int i{0}; i < count; ++i) {
+      auto const start{now_ns()};
+      cmd.send_to_stdin(line);
+      while (cmd.read_stdout(true).size() < line.size()) {
+      }
+      samples_us.push_back(static_cast<double>(now_ns() - start) / 1000);
+      static_cast<void>(cmd.get_stdout());
+    }
+    cmd.close_stdin();
+    cmd.finish();
+  }
+  report_latencies(ctx, "exec_path_args", samples_us);
+
+  samples_us.clear();
+  {
+    process_group group;
+    auto const i{group.add(std::string{ctx.some_cli_app}, {"--binary-echo"})};
+    static_cast<void>(group.spawn_all());
+    for (int k{0}; k < count; ++k) {
+      auto const start{now_ns()};
+      group.send_to_stdin(i, line);
+      while (group.read_stdout(i).size() < line.size()) {
+        static_cast<void>(group.update_all(-1));
+      }
+      samples_us.push_back(static_cast<double>(now_ns() - start) / 1000);
+      static_cast<void>(group.get_stdout(i));
+    }
+    group.close_stdin(i);
+    group.finish_all();
+  }
+  report_latencies(ctx, "process_group", samples_us);
+
+  samples_us.clear();
+  {
+    raw_echo echo{ctx.some_cli_app};
+    char buffer[16];
+    for (int i{0}; i < count; ++i) {
+      auto const start{now_ns()};
+      static_cast<void>(write(echo.to_child, line.data(), line.size()));
+      std::size_t got{0};
+      while (got < line.size()) {
+        auto const n{read(echo.from_child, buffer, sizeof(buffer))};
+        if (n <= 0) {
+          std::abort();
+        }
+        got += static_cast<std::size_t>(n);
+      }
+      samples_us.push_back(static_cast<double>(now_ns() - start) / 1000);
+    }
+  }
+  report_latencies(ctx, "raw_pipes", samples_us);
+}
+
+// records of a few pieces (header, payload & trailer) to
+// `some_cli_app --discard-stdin`: concatenated first, a `write` per piece, or
+// gathered by a single `writev`
+EXEC_PATH_ARGS_BENCHMARK(stdin_gather) {
+  int const count{ctx.scaled(100'000)};
+  std::string const header(16, 'h');
+  std::string const trailer{"\n"};
+
+  for (auto const &[suffix, payload_size] :
+       {std::pair{"_200B", 200}, {"_16KiB", 16 * 1024}}) {
+    std::string const payload(static_cast<std::size_t>(payload_size), 'p');
+    auto const run = [&](std::string const &metric, auto const &send_one) {
+      exec_path_args cmd{std::string{ctx.some_cli_app}, {"--discard-stdin"}};
+      static_cast<void>(cmd.update_and_get_state());
+      auto const start{now_ns()};
+      for (int i{0}; i < count; ++i) {
+        send_one(cmd);
+      }
+      ctx.report(metric + suffix,
+                 static_cast<double>(now_ns() - start) / count, "ns/record");
+      cmd.close_stdin();
+      cmd.finish();
+    };
+
+    std::string record;
+    run("concatenated", [&](exec_path_args &cmd) {
+      record.clear();
+      record += header;
+      record += payload;
+      record += trailer;
+      cmd.send_to_stdin(record);
+    });
+    run("write_per_piece", [&](exec_path_args &cmd) {
+      cmd.send_to_stdin(header);
+      cmd.send_to_stdin(payload);
+      cmd.send_to_stdin(trailer);
+    });
+    run("writev", [&](exec_path_args &cmd) {
+      cmd.send_to_stdin({header, payload, trailer});
+    });
+  }
+}
+
+// a large input for `some_cli_app --discard-stdin`: pushed through the pipe
+// (`send_to_stdin`), handed over as its stdin directly - a sealed memfd
+// (including copying the buffer into it, or already prepared), or an already
+// open file - or pulled from a `process_group::stdin_producer`
+EXEC_PATH_ARGS_BENCHMARK(stdin_bandwidth) {
+  std::string const data(
+      static_cast<std::size_t>(ctx.scaled(256)) * 1024 * 1024, 'x');
+  auto const report = [&ctx, &data](char const *const metric,
+                                    long long const elapsed_ns) {
+    ctx.report(metric, static_cast<double>(data.size()) * 1e9 / (1 << 20) /
+                           static_cast<double>(elapsed_ns),
+               "MiB/s");
+  };
+
+  {
+    auto const start{now_ns()};
+    exec_path_args cmd{std::string{ctx.some_cli_app}, {"--discard-stdin"}};
+    static_cast<void>(cmd.update_and_get_state());
+    cmd.send_to_stdin(data);
+    cmd.close_stdin();
+    cmd.finish();
+    report("send_to_stdin", now_ns() - start);
+  }
+
+  {
+    auto const start{now_ns()};
+    auto const fd{os_wrapper::sealed_memfd(data)};
+    auto const run_child = [&ctx](int const stdin_fd) {
+      os_wrapper::spawn_options options;
+      options.stdin_fd = stdin_fd;
+      exec_path_args cmd{std::string{ctx.some_cli_app},
+                         {"--discard-stdin"},
+                         std::move(options)};
+      cmd.finish();
+    };
+    run_child(fd);
+    report("sealed_memfd", now_ns() - start);
+
+    // once it exists, e.g. for another child (with an offset of its own)
+    auto const reuse_start{now_ns()};
+    auto const reopened{open(("/proc/self/fd/" + std::to_string(fd)).c_str(),
+                             O_RDONLY | O_CLOEXEC)};
+    run_child(reopened);
+    close(reopened);
+    report("sealed_memfd_reused", now_ns() - reuse_start);
+    close(fd);
+  }
+
+  {
+    auto const file{std::filesystem::temp_directory_path() /
+                    ("exec_path_args_bench_" + std::to_string(getpid()))};
+    {
+      std::ofstream out{file, std::ios::binary};
+      out << data;
+    }
+    auto const start{now_ns()};
+    auto const fd{open(file.c_str(), O_RDONLY | O_CLOEXEC)};
+    os_wrapper::spawn_options options;
+    options.stdin_fd = fd;
+    exec_path_args cmd{std::string{ctx.some_cli_app},
+                       {"--discard-stdin"},
+                       std::move(options)};
+    cmd.finish();
+    close(fd);
+    report("file", now_ns() - start);
+    std::filesystem::remove(file);
+  }
+
+  // pulled by `process_group` from a producer (copying out of `data` there, as
+  // generating it would), as the pipe has room
+  {
+    auto const start{now_ns()};
+    process_group group;
+    auto const i{
+        group.add(std::string{ctx.some_cli_app}, {"--discard-stdin"})};
+    std::size_t produced{0};
+    group.set_stdin_producer(
+        i, [&data, &produced](char *const buffer, std::size_t const capacity) {
+          auto const n{std::min(capacity, data.size() - produced)};
+          std::memcpy(buffer, data.data() + produced, n);
+          produced += n;
+          return n;
+        });
+    static_cast<void>(group.spawn_all());
+    group.finish_all();
+    report("process_group_producer", now_ns() - start);
+  }
+}
+
+} // namespace exec_path_args::bench
@@ -0,0 +1,120 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <malloc.h>
+
+#include <string>
+#include <vector>
+
+#include "bench.hxx"
+#include "exec_path_args/exec_path_args.hxx"
+#include "exec_path_args/process_group.hxx"
+
+namespace exec_path_args::bench {
+namespace {
+
+using os_wrapper::exec_path_args;
+using os_wrapper::process_group;
+
+// https://man7.org/linux/man-pages/man3/mallinfo.3.html
+[[nodiscard]] long long heap_in_use() {
+  auto const info{mallinfo2()};
+  // (big blocks are `mmap`ed separately)
+  return static_cast<long long>(info.uordblks + info.hblkhd);
+}
+
+[[nodiscard]] std::vector<std::string> some_args() {
+  return {"sh", "-c", "echo 'some not so short command line'"};
+}
+
+void report_per_process(context &ctx, char const *const metric,
+                        long long const heap_before, int const count) {
+  ctx.report(metric,
+             static_cast<double>(heap_in_use() - heap_before) / count,
+             "bytes/process");
+}
+
+} // namespace
+
+// heap used per tracked process - not spawned yet, and spawned & finished (but
+// output not collected yet), before & after `shrink_to_fit`; plus what each
+// `exec_path_args` takes by itself (e.g. in a `std::vector`)
+EXEC_PATH_ARGS_BENCHMARK(memory_per_process) {
+  int const tracked{ctx.scaled(200'000)};
+  int const spawned{ctx.scaled(2'000)};
+
+  ctx.report("exec_path_args_sizeof",
+             static_cast<double>(sizeof(exec_path_args)), "bytes");
+
+  {
+    auto const before{heap_in_use()};
+    std::vector<exec_path_args> cmds;
+    cmds.reserve(tracked);
+    for (int i{0}; i < tracked; ++i) {
+      cmds.emplace_back("/usr/bin/env", some_args());
+    }
+    report_per_process(ctx, "exec_path_args_ready", before, tracked);
+  }
+
+  {
+    auto const before{heap_in_use()};
+    process_group group;
+    group.reserve(tracked);
+    for (int i{0}; i < tracked; ++i) {
+      static_cast<void>(group.add("/usr/bin/env", some_args()));
+    }
+    report_per_process(ctx, "process_group_ready", before, tracked);
+  }
+
+  {
+    auto const before{heap_in_use()};
+    std::vector<exec_path_args> cmds;
+    cmds.reserve(spawned);
+    for (int i{0}; i < spawned; ++i) {
+      cmds.emplace_back("/usr/bin/env", some_args());
+      cmds.back().finish();
+      static_cast<void>(cmds.back().read_stdout());
+    }
+    report_per_process(ctx, "exec_path_args_finished", before, spawned);
+    for (auto &cmd : cmds) {
+      cmd.shrink_to_fit();
+    }
+    report_per_process(ctx, "exec_path_args_shrunk", before, spawned);
+  }
+
+  {
+    auto const before{heap_in_use()};
+    process_group group;
+    group.reserve(spawned);
+    for (int i{0}; i < spawned; ++i) {
+      static_cast<void>(group.add("/usr/bin/env", some_args()));
+    }
+    // (in waves, so there aren't too many fds open at once)
+    for (int done{0}; done < spawned; done += 256) {
+      static_cast<void>(group.spawn_all(256));
+      group.finish_all();
+    }
+    static_cast<void>(group.collect_outputs());
+    report_per_process(ctx, "process_group_finished", before, spawned);
+    group.shrink_to_fit();
+    report_per_process(ctx, "process_group_shrunk", before, spawned);
+  }
+}
+
+} // namespace exec_path_args::bench
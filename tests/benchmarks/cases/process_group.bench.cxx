@@ -0,0 +1,117 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/process_group.hxx"
+
+#include <string>
+#include <vector>
+
+#include "bench.hxx"
+#include "exec_path_args/exec_path_args.hxx"
+
+namespace exec_path_args::bench {
+namespace {
+
+using os_wrapper::exec_path_args;
+using os_wrapper::process_group;
+
+} // namespace
+
+// spawn N short-lived children & wait for all of them
+EXEC_PATH_ARGS_BENCHMARK(process_group_wait_all) {
+  int const count{ctx.scaled(500)};
+
+  {
+    std::vector<exec_path_args> cmds;
+    for (int i{0}; i < count; ++i) {
+      cmds.emplace_back("/bin/true", std::vector<std::string>{});
+    }
+    auto const start{now_ns()};
+    for (auto &cmd : cmds) {
+      static_cast<void>(cmd.update_and_get_state());
+    }
+    // polling each of them, the way it had to be done so far
+    for (bool all_finished{false}; !all_finished;) {
+      all_finished = true;
+      for (auto &cmd : cmds) {
+        all_finished = (cmd.update_and_get_state().current ==
+                        exec_path_args::state::finished) &&
+                       all_finished;
+      }
+    }
+    ctx.report("vector_polling",
+               static_cast<double>(now_ns() - start) / count, "ns/process");
+  }
+
+  {
+    process_group group;
+    for (int i{0}; i < count; ++i) {
+      static_cast<void>(group.add("/bin/true", {}));
+    }
+    auto const start{now_ns()};
+    static_cast<void>(group.spawn_all());
+    group.finish_all();
+    ctx.report("process_group",
+               static_cast<double>(now_ns() - start) / count, "ns/process");
+  }
+}
+
+// just looking up which ones finished, in a big table
+EXEC_PATH_ARGS_BENCHMARK(process_group_scan) {
+  int const count{ctx.scaled(100'000)};
+  int const rounds{100};
+
+  {
+    std::vector<exec_path_args> cmds;
+    cmds.reserve(count);
+    for (int i{0}; i < count; ++i) {
+      cmds.emplace_back("/bin/true", std::vector<std::string>{});
+    }
+    std::size_t found{0};
+    auto const start{now_ns()};
+    for (int r{0}; r < rounds; ++r) {
+      for (auto const &cmd : cmds) {
+        found += cmd.is_finished() ? 1 : 0;
+      }
+    }
+    ctx.report("vector_is_finished",
+               static_cast<double>(now_ns() - start) / rounds / count,
+               "ns/entry");
+    ctx.report("vector_found", static_cast<double>(found), "entries");
+  }
+
+  {
+    process_group group;
+    group.reserve(count);
+    for (int i{0}; i < count; ++i) {
+      static_cast<void>(group.add("/bin/true", {}));
+    }
+    std::size_t found{0};
+    auto const start{now_ns()};
+    for (int r{0}; r < rounds; ++r) {
+      found += group.finished_indices().size();
+    }
+    ctx.report("group_finished_indices",
+               static_cast<double>(now_ns() - start) / rounds / count,
+               "ns/entry");
+    ctx.report("group_found", static_cast<double>(found), "entries");
+  }
+}
+
+} // namespace exec_path_args::bench
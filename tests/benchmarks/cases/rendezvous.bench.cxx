@@ -0,0 +1,85 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/rendezvous.hxx"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ips/ips.hxx>
+
+#include "bench.hxx"
+#include "exec_path_args/exec_path_args.hxx"
+
+namespace exec_path_args::bench {
+namespace {
+
+using os_wrapper::exec_path_args;
+using os_wrapper::spawn_options;
+
+// parent -> child -> parent, `count` times (the child doing `--ping-pong`)
+template <typename sync_t>
+void measure_round_trips(context &ctx, std::string const &prefix,
+                         sync_t &sync, int const count,
+                         std::vector<std::string> &&args,
+                         spawn_options &&options) {
+  args.insert(args.end(), {"--ping-pong", std::to_string(count)});
+  exec_path_args cmd{std::string{ctx.some_cli_app}, std::move(args),
+                     std::move(options)};
+  static_cast<void>(cmd.update_and_get_state());
+  std::vector<double> samples;
+  samples.reserve(static_cast<std::size_t>(count));
+  for (int i{0}; i < count; ++i) {
+    auto const start{now_ns()};
+    if (!sync.notify_and_wait(5000)) {
+      std::abort();
+    }
+    samples.push_back(static_cast<double>(now_ns() - start) / 1000);
+  }
+  cmd.finish();
+  ctx.report(prefix + "_p50", percentile(samples, 50), "us/round-trip");
+  ctx.report(prefix + "_p99", percentile(samples, 99), "us/round-trip");
+}
+
+} // namespace
+
+// the library's futex-based `rendezvous` vs. the tests' POSIX named semaphores
+EXEC_PATH_ARGS_BENCHMARK(rendezvous_round_trip) {
+  int const count{ctx.scaled(10'000)};
+
+  {
+    auto sync{os_wrapper::rendezvous::create()};
+    spawn_options options;
+    sync.pass_to(options, 3);
+    measure_round_trips(ctx, "rendezvous", sync, count, {}, std::move(options));
+  }
+
+  {
+    auto const name{"/exec_path_args_bench_" + std::to_string(getpid())};
+    ips sync{name, true};
+    measure_round_trips(ctx, "semaphores", sync, count, {"--sem-name", name},
+                        {});
+  }
+}
+
+} // namespace exec_path_args::bench
@@ -0,0 +1,102 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/run_log.hxx"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench.hxx"
+
+namespace exec_path_args::bench {
+
+using os_wrapper::run_log_reader;
+using os_wrapper::run_log_writer;
+using os_wrapper::run_record;
+
+// persisting a finished run - into the binary log, or as a line of JSON (what
+// used to be done ad hoc); & reading them all back
+EXEC_PATH_ARGS_BENCHMARK(run_log_append) {
+  int const count{ctx.scaled(1'000'000)};
+  auto const path{(std::filesystem::temp_directory_path() /
+                   ("exec_path_args_run_log." + std::to_string(getpid())))
+                      .string()};
+  std::vector<std::string> const args{"--some", "argument", "42"};
+
+  run_record record{};
+  record.user_cpu_ns = 123'456;
+  record.max_rss_kib = 4096;
+  {
+    auto const start{now_ns()};
+    {
+      run_log_writer log{path};
+      for (int i{0}; i < count; ++i) {
+        record.start_ns = i;
+        record.end_ns = i + 1'000;
+        log.append("/usr/bin/some_tool", args, record);
+      }
+    } // (including the final flush)
+    ctx.report("binary", static_cast<double>(now_ns() - start) / count,
+               "ns/record");
+  }
+
+  {
+    auto const start{now_ns()};
+    run_log_reader const log{path};
+    long long sum{0};
+    for (auto const &r : log) {
+      sum += r.end_ns - r.start_ns + static_cast<long long>(r.command_size);
+    }
+    ctx.report("binary_read", static_cast<double>(now_ns() - start) / count,
+               "ns/record");
+    if (sum == 42) {
+      ctx.report("(keeping the sum)", 0, "");
+    }
+  }
+  std::filesystem::remove(path);
+  std::filesystem::remove(path + ".strings");
+
+  {
+    auto const start{now_ns()};
+    {
+      std::ofstream out{path};
+      for (int i{0}; i < count; ++i) {
+        std::ostringstream line;
+        line << R"({"command": ["/usr/bin/some_tool")";
+        for (auto const &arg : args) {
+          line << R"(, ")" << arg << '"';
+        }
+        line << R"(], "start_ns": )" << i << R"(, "end_ns": )" << i + 1'000
+             << R"(, "return_code": 0, "user_cpu_ns": )" << record.user_cpu_ns
+             << R"(, "max_rss_kib": )" << record.max_rss_kib << "}\n";
+        out << line.str();
+      }
+    }
+    ctx.report("json", static_cast<double>(now_ns() - start) / count,
+               "ns/record");
+  }
+  std::filesystem::remove(path);
+}
+
+} // namespace exec_path_args::bench
@@ -0,0 +1,103 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/process_group.hxx"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "bench.hxx"
+
+namespace exec_path_args::bench {
+namespace {
+
+using os_wrapper::process_group;
+
+[[nodiscard]] long long cpu_ns_of_this_thread() {
+  rusage ru{};
+  getrusage(RUSAGE_THREAD, &ru);
+  auto const to_ns = [](timeval const &tv) {
+    return static_cast<long long>(tv.tv_sec) * 1'000'000'000 +
+           static_cast<long long>(tv.tv_usec) * 1'000;
+  };
+  return to_ns(ru.ru_utime) + to_ns(ru.ru_stime);
+}
+
+// CPU the parent spends waiting on `count` idle children for `duration_ms`,
+// with each of them sampled every `interval_ms` (`0` ~ not at all); returns
+// the total number of samples taken
+long long wait_on_idle(int const count, int const duration_ms,
+                       int const interval_ms, long long &cpu_ns) {
+  process_group group;
+  if (interval_ms > 0) {
+    group.enable_sampling(interval_ms, 1024);
+  }
+  for (int i{0}; i < count; ++i) {
+    static_cast<void>(group.add("/bin/sleep", {"3600"}));
+  }
+  static_cast<void>(group.spawn_all());
+
+  auto const start_cpu_ns{cpu_ns_of_this_thread()};
+  auto const until_ns{now_ns() + duration_ms * 1'000'000LL};
+  while (now_ns() < until_ns) {
+    static_cast<void>(group.update_all(static_cast<int>(
+        std::max<long long>((until_ns - now_ns()) / 1'000'000, 1))));
+  }
+  cpu_ns = cpu_ns_of_this_thread() - start_cpu_ns;
+
+  long long samples{0};
+  for (process_group::index_t i{0}; i < group.size(); ++i) {
+    samples += static_cast<long long>(group.samples(i).size());
+  }
+  group.kill_all();
+  return samples;
+}
+
+} // namespace
+
+// what sampling `/proc/<pid>/statm` & `schedstat` of running children costs the
+// parent - per sample & extrapolated to 10k children sampled once a second
+EXEC_PATH_ARGS_BENCHMARK(resource_sampling) {
+  int const count{ctx.scaled(500)};
+  int const duration_ms{std::max(200, ctx.scaled(2'000))};
+  static int constexpr interval_ms{10};
+
+  long long idle_cpu_ns{0};
+  static_cast<void>(wait_on_idle(count, duration_ms, 0, idle_cpu_ns));
+  long long sampling_cpu_ns{0};
+  auto const samples{
+      wait_on_idle(count, duration_ms, interval_ms, sampling_cpu_ns)};
+  if (samples == 0) {
+    return;
+  }
+
+  auto const per_sample_ns{
+      static_cast<double>(std::max(sampling_cpu_ns - idle_cpu_ns, 0LL)) /
+      static_cast<double>(samples)};
+  ctx.report("samples", static_cast<double>(samples), "samples");
+  ctx.report("cpu", per_sample_ns, "ns/sample");
+  // 10k samples a second, in % of a core
+  ctx.report("10k_children_at_1hz", per_sample_ns * 10'000 / 1e9 * 100,
+             "%core");
+}
+
+} // namespace exec_path_args::bench
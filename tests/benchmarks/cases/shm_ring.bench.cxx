@@ -0,0 +1,97 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/shm_ring.hxx"
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "bench.hxx"
+#include "exec_path_args/exec_path_args.hxx"
+#include "exec_path_args/process_group.hxx"
+
+namespace exec_path_args::bench {
+
+using os_wrapper::exec_path_args;
+using os_wrapper::process_group;
+using os_wrapper::shm_ring;
+using os_wrapper::spawn_options;
+
+// a child sending lots of data to the parent - through a shared memory ring
+// (used in place), or its stdout (the same as `stdout_bandwidth` does)
+EXEC_PATH_ARGS_BENCHMARK(shm_ring_bandwidth) {
+  long long const size{ctx.scaled(1024) * 1024LL * 1024};
+  auto const size_arg{std::to_string(size)};
+  auto const report = [&ctx, size](char const *const metric,
+                                   long long const elapsed_ns) {
+    ctx.report(metric, static_cast<double>(size) * 1e9 / (1 << 20) /
+                           static_cast<double>(elapsed_ns),
+               "MiB/s");
+  };
+
+  for (auto const &[metric, capacity] :
+       {std::pair{"shm_ring_1MiB", 1 << 20}, {"shm_ring_16MiB", 16 << 20}}) {
+    auto const start{now_ns()};
+    {
+      auto ring{shm_ring::create(static_cast<std::size_t>(capacity))};
+      spawn_options options;
+      ring.pass_to(options, 3);
+      exec_path_args cmd{std::string{ctx.some_cli_app},
+                         {"--ring-flood", size_arg},
+                         std::move(options)};
+      static_cast<void>(cmd.update_and_get_state());
+      long long total{0};
+      unsigned char sink{0};
+      for (auto data{ring.readable()}; !data.empty(); data = ring.readable()) {
+        sink ^= static_cast<unsigned char>(data.back()); // (touch it)
+        total += static_cast<long long>(data.size());
+        ring.release(data.size());
+      }
+      cmd.finish();
+      if (total != size) {
+        std::abort();
+      } else if (sink == 42) {
+        ctx.report("(keeping the data)", 0, "");
+      }
+    }
+    report(metric, now_ns() - start);
+  }
+
+  auto const start{now_ns()};
+  {
+    process_group group;
+    auto const i{group.add(std::string{ctx.some_cli_app},
+                           {"--flood-stdout", size_arg})};
+    static_cast<void>(group.spawn_all());
+    std::size_t total{0};
+    while (group.running() != 0) {
+      static_cast<void>(group.update_all(-1));
+      total += group.get_stdout(i).size();
+    }
+    static_cast<void>(group.collect_outputs());
+    total += group.get_stdout(i).size();
+    if (total != static_cast<std::size_t>(size)) {
+      std::abort();
+    }
+  }
+  report("pipe", now_ns() - start);
+}
+
+} // namespace exec_path_args::bench
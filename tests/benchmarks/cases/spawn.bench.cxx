@@ -0,0 +1,144 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "exec_path_args/exec_path_args.hxx"
+#include "exec_path_args/process_group.hxx"
+
+#include "bench.hxx"
+
+extern char **environ;
+
+namespace exec_path_args::bench {
+namespace {
+
+using os_wrapper::exec_path_args;
+using os_wrapper::process_group;
+
+void report_latencies(context &ctx, std::string const &prefix,
+                      std::vector<double> &samples_us) {
+  ctx.report(prefix + "_p50", percentile(samples_us, 50), "us");
+  ctx.report(prefix + "_p99", percentile(samples_us, 99), "us");
+}
+
+template <typename run_fn>
+void measure_latency(context &ctx, std::string const &prefix, int const count,
+                     run_fn &&run) {
+  std::vector<double> samples_us;
+  samples_us.reserve(count);
+  for (int i{0}; i < count; ++i) {
+    auto const start{now_ns()};
+    run();
+    samples_us.push_back(static_cast<double>(now_ns() - start) / 1000);
+  }
+  report_latencies(ctx, prefix, samples_us);
+}
+
+[[nodiscard]] pid_t posix_spawn_true() {
+  static char arg0[]{"true"};
+  static char *const argv[]{arg0, nullptr};
+  pid_t pid;
+  if (posix_spawn(&pid, "/bin/true", nullptr, nullptr, argv, environ) != 0) {
+    std::abort();
+  }
+  return pid;
+}
+
+} // namespace
+
+// `/bin/true` from spawning until its exit is noticed; the baselines: plain
+// `posix_spawn` + `waitpid`, `system` & `popen` (both through `/bin/sh`)
+EXEC_PATH_ARGS_BENCHMARK(spawn_latency) {
+  int const count{ctx.scaled(1000)};
+
+  measure_latency(ctx, "exec_path_args", count, [] {
+    exec_path_args cmd{"/bin/true", {}};
+    cmd.finish();
+  });
+  measure_latency(ctx, "posix_spawn", count, [] {
+    int status;
+    waitpid(posix_spawn_true(), &status, 0);
+  });
+  measure_latency(ctx, "system", count,
+                  [] { static_cast<void>(std::system("/bin/true")); });
+  measure_latency(ctx, "popen", count, [] {
+    auto *const f{popen("/bin/true", "r")};
+    static_cast<void>(pclose(f));
+  });
+}
+
+// `/bin/true`, `parallel` children at a time
+EXEC_PATH_ARGS_BENCHMARK(spawn_throughput) {
+  static int constexpr parallel{64};
+  int const rounds{ctx.scaled(20)};
+  auto const report = [&ctx, rounds](char const *const metric,
+                                     long long const elapsed_ns) {
+    ctx.report(metric,
+               rounds * parallel * 1e9 / static_cast<double>(elapsed_ns),
+               "spawns/s");
+  };
+
+  auto start{now_ns()};
+  for (int r{0}; r < rounds; ++r) {
+    std::vector<exec_path_args> cmds;
+    cmds.reserve(parallel);
+    for (int i{0}; i < parallel; ++i) {
+      cmds.emplace_back("/bin/true", std::vector<std::string>{});
+      static_cast<void>(cmds.back().update_and_get_state());
+    }
+    for (auto &cmd : cmds) {
+      cmd.finish();
+    }
+  }
+  report("exec_path_args", now_ns() - start);
+
+  start = now_ns();
+  for (int r{0}; r < rounds; ++r) {
+    process_group group;
+    group.reserve(parallel);
+    for (int i{0}; i < parallel; ++i) {
+      static_cast<void>(group.add("/bin/true", {}));
+    }
+    static_cast<void>(group.spawn_all());
+    group.finish_all();
+  }
+  report("process_group", now_ns() - start);
+
+  start = now_ns();
+  for (int r{0}; r < rounds; ++r) {
+    std::vector<pid_t> pids;
+    for (int i{0}; i < parallel; ++i) {
+      pids.push_back(posix_spawn_true());
+    }
+    for (auto const pid : pids) {
+      int status;
+      waitpid(pid, &status, 0);
+    }
+  }
+  report("posix_spawn", now_ns() - start);
+}
+
+} // namespace exec_path_args::bench
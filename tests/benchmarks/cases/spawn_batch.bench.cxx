@@ -0,0 +1,77 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/spawn_batch.hxx"
+
+#include <string>
+#include <vector>
+
+#include "bench.hxx"
+
+namespace exec_path_args::bench {
+namespace {
+
+using os_wrapper::exec_path_args;
+
+[[nodiscard]] std::vector<exec_path_args> make_cmds(int const count) {
+  std::vector<exec_path_args> cmds;
+  cmds.reserve(count);
+  for (int i{0}; i < count; ++i) {
+    cmds.emplace_back("/bin/true", std::vector<std::string>{});
+  }
+  return cmds;
+}
+
+// spawning only (children are reaped afterwards, outside of the measurement)
+template <typename spawn_all_fn>
+void measure_spawns(context &ctx, char const *const metric, int const count,
+                    spawn_all_fn &&spawn_all) {
+  auto cmds{make_cmds(count)};
+  auto const start{now_ns()};
+  spawn_all(cmds);
+  auto const elapsed_ns{now_ns() - start};
+  for (auto &cmd : cmds) {
+    cmd.finish();
+  }
+  ctx.report(metric, count * 1e9 / static_cast<double>(elapsed_ns),
+             "spawns/s");
+}
+
+} // namespace
+
+EXEC_PATH_ARGS_BENCHMARK(spawn_batch_vs_loop) {
+  int const count{ctx.scaled(500)};
+
+  measure_spawns(ctx, "loop", count, [](std::vector<exec_path_args> &cmds) {
+    for (auto &cmd : cmds) {
+      static_cast<void>(cmd.update_and_get_state());
+    }
+  });
+
+  for (int const num_threads : {1, 2, 4}) {
+    auto const metric{"batch_" + std::to_string(num_threads) + "_threads"};
+    measure_spawns(ctx, metric.c_str(), count,
+                   [num_threads](std::vector<exec_path_args> &cmds) {
+                     static_cast<void>(
+                         os_wrapper::spawn_batch(cmds, num_threads));
+                   });
+  }
+}
+
+} // namespace exec_path_args::bench
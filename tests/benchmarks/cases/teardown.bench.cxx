@@ -0,0 +1,77 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/kill_all.hxx"
+
+#include <string>
+#include <vector>
+
+#include "bench.hxx"
+
+namespace exec_path_args::bench {
+namespace {
+
+using os_wrapper::exec_path_args;
+
+[[nodiscard]] std::vector<exec_path_args> spawn_sleepers(int const count) {
+  std::vector<exec_path_args> cmds;
+  cmds.reserve(count);
+  for (int i{0}; i < count; ++i) {
+    cmds.emplace_back("/bin/sleep", std::vector<std::string>{"10"});
+    static_cast<void>(cmds.back().update_and_get_state());
+  }
+  return cmds;
+}
+
+template <typename teardown_fn>
+void measure_teardown(context &ctx, char const *const metric, int const count,
+                      teardown_fn &&teardown) {
+  auto cmds{spawn_sleepers(count)};
+  auto const start{now_ns()};
+  teardown(cmds);
+  ctx.report(metric, static_cast<double>(now_ns() - start) / count,
+             "ns/process");
+}
+
+} // namespace
+
+// getting rid of many still running children
+EXEC_PATH_ARGS_BENCHMARK(teardown_running) {
+  int const count{ctx.scaled(500)};
+
+  measure_teardown(ctx, "do_kill_loop", count,
+                   [](std::vector<exec_path_args> &cmds) {
+                     for (auto &cmd : cmds) {
+                       cmd.do_kill();
+                     }
+                     cmds.clear();
+                   });
+
+  measure_teardown(ctx, "kill_all", count,
+                   [](std::vector<exec_path_args> &cmds) {
+                     os_wrapper::kill_all(cmds);
+                     cmds.clear();
+                   });
+
+  // (the reaper keeps working after this)
+  measure_teardown(ctx, "destructors", count,
+                   [](std::vector<exec_path_args> &cmds) { cmds.clear(); });
+}
+
+} // namespace exec_path_args::bench
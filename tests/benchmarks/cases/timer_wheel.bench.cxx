@@ -0,0 +1,79 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "impl/timer_wheel.hxx"
+
+#include <cstdint>
+#include <vector>
+
+#include "bench.hxx"
+
+namespace exec_path_args::bench {
+
+using os_wrapper::timer_wheel;
+
+// many concurrent deadlines - arming, re-arming (e.g. an inactivity timeout
+// pushed back on output), cancelling & letting them all expire
+EXEC_PATH_ARGS_BENCHMARK(timer_deadlines) {
+  int const count{ctx.scaled(100'000)};
+
+  std::vector<timer_wheel::tick_t> expiries(count);
+  std::uint64_t lcg{7};
+  for (auto &expiry : expiries) {
+    lcg = lcg * 6364136223846793005ull + 1442695040888963407ull;
+    expiry = 1 + static_cast<timer_wheel::tick_t>((lcg >> 33) % 600'000);
+  }
+
+  timer_wheel wheel;
+  auto start{now_ns()};
+  for (int i{0}; i < count; ++i) {
+    wheel.arm(static_cast<timer_wheel::timer_id>(i), expiries[i]);
+  }
+  ctx.report("arm", static_cast<double>(now_ns() - start) / count, "ns/timer");
+
+  start = now_ns();
+  for (int i{0}; i < count; ++i) {
+    wheel.arm(static_cast<timer_wheel::timer_id>(i), expiries[i] + 1000);
+  }
+  ctx.report("rearm", static_cast<double>(now_ns() - start) / count,
+             "ns/timer");
+
+  // advancing a millisecond at a time, as a busy reactor would
+  std::size_t expired{0};
+  start = now_ns();
+  while (wheel.size() != 0) {
+    wheel.advance(wheel.now() + 1,
+                  [&expired](timer_wheel::timer_id) { ++expired; });
+  }
+  ctx.report("expire", static_cast<double>(now_ns() - start) / expired,
+             "ns/timer");
+
+  for (int i{0}; i < count; ++i) {
+    wheel.arm(static_cast<timer_wheel::timer_id>(i),
+              wheel.now() + expiries[i]);
+  }
+  start = now_ns();
+  for (int i{0}; i < count; ++i) {
+    wheel.cancel(static_cast<timer_wheel::timer_id>(i));
+  }
+  ctx.report("cancel", static_cast<double>(now_ns() - start) / count,
+             "ns/timer");
+}
+
+} // namespace exec_path_args::bench
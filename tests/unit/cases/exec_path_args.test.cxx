@@ -19,18 +19,32 @@
 
 #include "exec_path_args/exec_path_args.hxx"
 
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <csignal>
+#include <cstdio>
 
 #include <algorithm>
+#include <exception>
 #include <filesystem>
+#include <iterator>
 #include <iostream>
 #include <new>
 #include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include <doctest/doctest.h>
 
 #include <ips/ips.hxx>
 
+#include "exec_path_args/sealed_memfd.hxx"
+
 namespace exec_path_args::os_wrapper {
 namespace {
 
@@ -121,6 +135,23 @@ TEST_CASE("exec_path_args") {
       REQUIRE_LT(0.0, cmd.time_running_ms());
     }
 
+    SUBCASE("shrinking once finished") {
+      exec_path_args cmd{shell_cmd("printf out; printf err 1>&2; exit 3")};
+
+      REQUIRE_THROWS(cmd.shrink_to_fit()); // not finished yet
+      REQUIRE_NOTHROW(cmd.finish());
+      REQUIRE_EQ(cmd.read_stdout(false), "out");
+      // stderr wasn't read at all before closing the pipes:
+      REQUIRE_NOTHROW(cmd.shrink_to_fit());
+      REQUIRE_NOTHROW(cmd.shrink_to_fit()); // no-op
+
+      REQUIRE_EQ(cmd.read_stdout(false), "");
+      REQUIRE_EQ(cmd.read_stdout(true), "out");
+      REQUIRE_EQ(cmd.get_stderr(), "err");
+      REQUIRE_EQ(cmd.get_return_code(), 3);
+      REQUIRE_THROWS(cmd.send_to_stdin("x"));
+    }
+
     SUBCASE("non-zero return code") {
       static auto constexpr expected_val{42};
       exec_path_args cmd{shell_cmd("exit " + std::to_string(expected_val))};
@@ -168,6 +199,7 @@ TEST_CASE("exec_path_args") {
       REQUIRE_EQ(cmd.read_stdout(true), "");
       REQUIRE_EQ(cmd.read_stderr(true), "");
       REQUIRE_NE(cmd.get_return_code(), EXIT_SUCCESS);
+      REQUIRE_EQ(cmd.get_exit_reason(), exec_path_args::exit_reason::killed);
       REQUIRE_LT(0.0, cmd.time_running_ms());
     }
 
@@ -297,6 +329,8 @@ TEST_CASE("exec_path_args") {
           [[maybe_unused]] double time_ms;
 
           REQUIRE_THROWS(ret_code = cmd_default_constructed.get_return_code());
+          REQUIRE_THROWS(static_cast<void>(
+              cmd_default_constructed.get_exit_reason()));
           REQUIRE_THROWS(time_ms = cmd_default_constructed.time_running_ms());
 
           REQUIRE_THROWS(ret_code = cmd_moved_from.get_return_code());
@@ -590,6 +624,82 @@ TEST_CASE("exec_path_args") {
         REQUIRE_LT(0.0, cmd.time_running_ms());
       }
 
+      SUBCASE("benchmark modes") {
+        exec_path_args flood{some_cli_app("--lines-stdout", "1000",  // ...
+                                          "--flood-stderr", "100000" // ...
+                                          )};
+        REQUIRE_NOTHROW(flood.update_and_get_state());
+        std::string out;
+        std::string err;
+        while (!flood.is_finished()) {
+          static_cast<void>(flood.update_and_get_state(1));
+          out += flood.get_stdout();
+          err += flood.get_stderr();
+        }
+        out += flood.get_stdout();
+        err += flood.get_stderr();
+        REQUIRE_EQ(std::count(out.begin(), out.end(), '\n'), 1000);
+        REQUIRE_EQ(out.substr(out.size() - 9), "line 999\n");
+        REQUIRE_EQ(err, std::string(100000, 'x'));
+
+        exec_path_args echo{some_cli_app("--binary-echo")};
+        REQUIRE_NOTHROW(echo.update_and_get_state());
+        auto const text{std::string{"no\0newline", 10}};
+        REQUIRE_NOTHROW(echo.send_to_stdin(text));
+        while (echo.read_stdout(true).size() < text.size()) {
+          static_cast<void>(echo.update_and_get_state(1));
+        }
+        REQUIRE_EQ(echo.read_stdout(true), text);
+        REQUIRE_NOTHROW(echo.close_stdin());
+        REQUIRE_NOTHROW(echo.finish());
+
+        exec_path_args discard{some_cli_app("--discard-stdin", // ...
+                                            "--ballast", "8",  // ...
+                                            "--grandchildren", "1", "10")};
+        REQUIRE_NOTHROW(discard.update_and_get_state());
+        REQUIRE_NOTHROW(discard.send_to_stdin(std::string(100000, 'y')));
+        REQUIRE_NOTHROW(discard.close_stdin());
+        REQUIRE_NOTHROW(discard.finish());
+        REQUIRE_EQ(discard.get_return_code(), EXIT_SUCCESS);
+        REQUIRE_EQ(discard.read_stdout(true), "");
+      }
+
+      SUBCASE("scatter-gather & partial stdin writes") {
+        exec_path_args echo{some_cli_app("--binary-echo")};
+        REQUIRE_NOTHROW(echo.update_and_get_state());
+        std::string const payload(1000, 'p'); // (fits the pipes)
+        REQUIRE_NOTHROW(echo.send_to_stdin({"head|", "", payload, "|tail"}));
+        // (more pieces than a single `writev` takes)
+        std::vector<std::string_view> const digits(200, "0123456789");
+        REQUIRE_NOTHROW(echo.send_to_stdin(digits.data(), digits.size()));
+        REQUIRE_NOTHROW(echo.close_stdin());
+        REQUIRE_NOTHROW(echo.finish());
+        std::string expected{"head|" + payload + "|tail"};
+        for (auto const &digit : digits) {
+          expected += digit;
+        }
+        REQUIRE_EQ(echo.read_stdout(true), expected);
+
+        // not reading anything for a while
+        exec_path_args slow{some_cli_app("--sleep", "300", // ...
+                                         "--discard-stdin")};
+        REQUIRE_NOTHROW(slow.update_and_get_state());
+        std::string const big(4 * 1024 * 1024, 'b');
+        std::size_t accepted{0};
+        REQUIRE_NOTHROW(accepted = slow.try_send_to_stdin(big));
+        REQUIRE_GT(accepted, 0u);
+        REQUIRE_LT(accepted, big.size()); // (the pipe is full)
+        std::size_t more{1};
+        REQUIRE_NOTHROW(more = slow.try_send_to_stdin(big));
+        REQUIRE_EQ(more, 0u);
+        REQUIRE_NOTHROW(slow.send_to_stdin(
+            std::string_view{big}.substr(accepted))); // (waits for it)
+        REQUIRE_NOTHROW(slow.close_stdin());
+        REQUIRE_THROWS(slow.try_send_to_stdin("x"));
+        REQUIRE_NOTHROW(slow.finish());
+        REQUIRE_EQ(slow.get_return_code(), EXIT_SUCCESS);
+      }
+
       SUBCASE("handled exception") {
         auto const exit_code{"14"};
         auto const exception_text{"handled"};
@@ -640,6 +750,8 @@ TEST_CASE("exec_path_args") {
         REQUIRE_EQ(cmd.read_stdout(true), "");
         REQUIRE_NE(cmd.get_return_code(), std::stoi(exit_code));
         REQUIRE_EQ(cmd.get_return_code(), SIGABRT);
+        REQUIRE_EQ(cmd.get_exit_reason(),
+                   exec_path_args::exit_reason::signaled);
         REQUIRE_LT(0.0, cmd.time_running_ms());
       }
     }
@@ -976,6 +1088,415 @@ TEST_CASE("exec_path_args") {
       }
     }
   }
+
+  SUBCASE("concurrent spawns don't leak fds") {
+    static auto constexpr count_own_fds = []() {
+      auto const it{std::filesystem::directory_iterator{"/proc/self/fd"}};
+      return std::distance(std::filesystem::begin(it),
+                           std::filesystem::end(it));
+    };
+
+    static int constexpr num_threads{8};
+    static int constexpr spawns_per_thread{16};
+
+    auto const fds_before{count_own_fds()};
+
+    // (assertions only in this thread)
+    std::vector<std::string> children_fds(num_threads * spawns_per_thread);
+    std::vector<std::thread> threads;
+    for (int t{0}; t < num_threads; ++t) {
+      threads.emplace_back([t, &children_fds]() {
+        for (int i{0}; i < spawns_per_thread; ++i) {
+          auto &result{children_fds[t * spawns_per_thread + i]};
+          try {
+            // keep all of them running for a while, so they overlap:
+            exec_path_args cmd{"/usr/bin/env",
+                               {"sh", "-c", "ls /proc/$$/fd; sleep 0.01"}};
+            cmd.finish();
+            result = cmd.get_stdout();
+          } catch (std::exception const &e) {
+            result = e.what();
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    for (auto const &child_fds : children_fds) {
+      REQUIRE_EQ(child_fds, "0\n1\n2\n");
+    }
+    REQUIRE_EQ(count_own_fds(), fds_before);
+  }
+
+  SUBCASE("spawn options") {
+    static auto constexpr shell_cmd = [](std::string &&cmd_str,
+                                         spawn_options &&options) {
+      exec_path_args cmd{"/usr/bin/env",
+                         {"sh", "-c", std::move(cmd_str)},
+                         std::move(options)};
+
+      REQUIRE_FALSE(cmd.manages_process());
+      REQUIRE_FALSE(cmd.is_finished());
+      return cmd;
+    };
+
+    static auto constexpr spawn_error = [](exec_path_args &cmd) {
+      std::string what;
+      try {
+        cmd.finish();
+      } catch (std::runtime_error const &e) {
+        what = e.what();
+      }
+      REQUIRE_FALSE(cmd.manages_process());
+      REQUIRE_FALSE(cmd.is_finished());
+      return what;
+    };
+
+    // see https://man7.org/linux/man-pages/man5/proc_pid_stat.5.html
+    static auto constexpr stat_field = [](int const field) {
+      return "cut -d ' ' -f " + std::to_string(field) + " /proc/self/stat";
+    };
+
+    SUBCASE("CPU affinity") {
+      spawn_options options;
+      options.cpu_affinity = {0};
+      exec_path_args cmd{shell_cmd("grep Cpus_allowed_list /proc/self/status",
+                                   std::move(options))};
+
+      REQUIRE_NOTHROW(cmd.finish());
+      REQUIRE_EQ(cmd.read_stdout(true), "Cpus_allowed_list:\t0\n");
+      REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+    }
+
+    SUBCASE("nice value") {
+      spawn_options options;
+      options.nice_value = 19;
+      exec_path_args cmd{shell_cmd(stat_field(19), std::move(options))};
+
+      REQUIRE_NOTHROW(cmd.finish());
+      REQUIRE_EQ(cmd.read_stdout(true), "19\n");
+      REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+    }
+
+    SUBCASE("scheduling policy") {
+      spawn_options options;
+      std::string expected;
+
+      SUBCASE("batch") {
+        options.scheduling = spawn_options::scheduling_policy::batch;
+        expected = std::to_string(SCHED_BATCH) + '\n';
+      }
+
+      SUBCASE("idle") {
+        options.scheduling = spawn_options::scheduling_policy::idle;
+        expected = std::to_string(SCHED_IDLE) + '\n';
+      }
+
+      exec_path_args cmd{shell_cmd(stat_field(41), std::move(options))};
+
+      REQUIRE_NOTHROW(cmd.finish());
+      REQUIRE_EQ(cmd.read_stdout(true), expected);
+      REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+    }
+
+    SUBCASE("I/O priority") {
+      spawn_options options;
+      options.io_priority = spawn_options::io_priority_class::best_effort;
+      options.io_priority_level = 7;
+      exec_path_args cmd{shell_cmd("ionice", std::move(options))};
+
+      REQUIRE_NOTHROW(cmd.finish());
+      // `ionice` is part of `util-linux`, so it's usually there ...:
+      WARN_EQ(cmd.read_stdout(true), "best-effort: prio 7\n");
+    }
+
+    SUBCASE("NUMA policy") {
+      spawn_options options;
+      options.numa_policy = spawn_options::memory_policy::bind;
+      options.numa_nodes = {0};
+      exec_path_args cmd{shell_cmd("exit 0", std::move(options))};
+
+      // kernels without `CONFIG_NUMA` refuse it -> but it must be reported
+      // properly:
+      try {
+        cmd.finish();
+        REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+      } catch (std::runtime_error const &e) {
+        REQUIRE_NE(std::string_view{e.what()}.find("`set_mempolicy` failed"),
+                   std::string_view::npos);
+      }
+    }
+
+    SUBCASE("resource limits") {
+      spawn_options options;
+
+      SUBCASE("applied") {
+        options.resource_limits = {{RLIMIT_NOFILE, 42, 64},
+                                   {RLIMIT_AS, 1 << 30, RLIM_INFINITY}};
+        // `ulimit -v` is in KiB
+        exec_path_args cmd{shell_cmd("ulimit -n; ulimit -Hn; ulimit -v",
+                                     std::move(options))};
+
+        REQUIRE_NOTHROW(cmd.finish());
+        REQUIRE_EQ(cmd.read_stdout(true), "42\n64\n1048576\n");
+        REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+        REQUIRE_EQ(cmd.get_exit_reason(), exec_path_args::exit_reason::exited);
+      }
+
+      SUBCASE("CPU time exceeded") {
+        options.resource_limits = {{RLIMIT_CPU, 1, 2}};
+        exec_path_args cmd{
+            shell_cmd("while :; do :; done", std::move(options))};
+
+        REQUIRE_NOTHROW(cmd.finish());
+        REQUIRE_EQ(cmd.get_return_code(), SIGXCPU);
+        REQUIRE_EQ(cmd.get_exit_reason(),
+                   exec_path_args::exit_reason::cpu_limit_exceeded);
+      }
+
+      SUBCASE("CPU limit configured but killed explicitly") {
+        options.resource_limits = {{RLIMIT_CPU, 10, 10}};
+        exec_path_args cmd{shell_cmd("sleep 10", std::move(options))};
+
+        REQUIRE_NOTHROW(cmd.update_and_get_state());
+        REQUIRE_NOTHROW(cmd.do_kill());
+        REQUIRE_EQ(cmd.get_return_code(), SIGKILL);
+        REQUIRE_EQ(cmd.get_exit_reason(), exec_path_args::exit_reason::killed);
+      }
+
+      SUBCASE("file size exceeded") {
+        auto const file{std::filesystem::temp_directory_path() /
+                        "exec_path_args_rlimit_fsize.test"};
+        options.resource_limits = {{RLIMIT_FSIZE, 1024, 1024}};
+        exec_path_args cmd{"/usr/bin/env",
+                           {"sh", "-c", "exec head -c 4096 /dev/zero > \"$0\"",
+                            file.string()},
+                           std::move(options)};
+
+        REQUIRE_NOTHROW(cmd.finish());
+        std::filesystem::remove(file);
+        REQUIRE_EQ(cmd.get_return_code(), SIGXFSZ);
+        REQUIRE_EQ(cmd.get_exit_reason(),
+                   exec_path_args::exit_reason::file_size_limit_exceeded);
+      }
+
+      SUBCASE("invalid") {
+        options.resource_limits = {{RLIMIT_NOFILE, 64, 42}};
+        exec_path_args cmd{shell_cmd("exit 0", std::move(options))};
+
+        REQUIRE_NE(spawn_error(cmd).find("invalid spawn options"),
+                   std::string::npos);
+      }
+
+      SUBCASE("refused by the kernel") {
+        // raising the hard limit above `nr_open` fails even for root:
+        options.resource_limits = {
+            {RLIMIT_NOFILE, RLIM_INFINITY, RLIM_INFINITY}};
+        exec_path_args cmd{shell_cmd("exit 0", std::move(options))};
+
+        REQUIRE_NE(spawn_error(cmd).find("`setrlimit` (resource " +
+                                         std::to_string(RLIMIT_NOFILE) +
+                                         ") failed"),
+                   std::string::npos);
+      }
+    }
+
+    SUBCASE("extra fds") {
+      spawn_options options;
+
+      SUBCASE("captured") {
+        options.extra_fds = {{3}, {5}};
+        exec_path_args cmd{shell_cmd("printf 'out'; printf 'three' >&3; "
+                                     "printf 'five' >&5; printf 'err' >&2",
+                                     std::move(options))};
+
+        REQUIRE_NOTHROW(cmd.finish());
+        REQUIRE_EQ(cmd.read_stdout(true), "out");
+        REQUIRE_EQ(cmd.read_stderr(true), "err");
+        REQUIRE_EQ(cmd.read_extra_output(3), "three");
+        REQUIRE_EQ(cmd.read_extra_output(3), "");
+        REQUIRE_EQ(cmd.read_extra_output(3, true), "three");
+        REQUIRE_EQ(cmd.get_extra_output(5), "five");
+        REQUIRE_EQ(cmd.get_extra_output(5), "");
+        REQUIRE_THROWS(static_cast<void>(cmd.read_extra_output(4)));
+        REQUIRE_NOTHROW(cmd.shrink_to_fit());
+        REQUIRE_EQ(cmd.read_extra_output(3, true), "three");
+        REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+      }
+
+      SUBCASE("passed from parent") {
+        pipe_helper side_channel;
+        side_channel.init();
+        options.extra_fds = {{7, side_channel.get_in()}};
+        exec_path_args cmd{
+            shell_cmd("printf 'passed' >&7", std::move(options))};
+
+        REQUIRE_NOTHROW(cmd.finish());
+        side_channel.close_in(); // still owned by the parent
+        char buf[16]{};
+        REQUIRE_EQ(read(side_channel.get_out(), buf, sizeof(buf)), 6);
+        REQUIRE_EQ(std::string_view{buf}, "passed");
+        REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+      }
+
+      SUBCASE("nothing else leaks into the child") {
+        pipe_helper not_inherited; // without `O_CLOEXEC` ...
+        not_inherited.init();
+        options.extra_fds = {{3}};
+        exec_path_args cmd{shell_cmd("ls /proc/$$/fd", std::move(options))};
+
+        REQUIRE_NOTHROW(cmd.finish());
+        REQUIRE_EQ(cmd.read_stdout(true), "0\n1\n2\n3\n");
+        REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+      }
+
+      SUBCASE("target colliding with a source") {
+        pipe_helper side_channel;
+        side_channel.init();
+        auto const fd{side_channel.get_in()};
+        // the child gets a new (captured) pipe at the very number the parent's
+        // own fd has, while the parent's one is passed elsewhere:
+        options.extra_fds = {{fd}, {fd + 100, fd}};
+        // (`bash`, because e.g. `dash` supports only single digit fds)
+        exec_path_args cmd{"/usr/bin/env",
+                           {"bash", "-c",
+                            "printf 'a' >&" + std::to_string(fd) +
+                                "; printf 'b' >&" + std::to_string(fd + 100)},
+                           std::move(options)};
+
+        REQUIRE_NOTHROW(cmd.finish());
+        side_channel.close_in();
+        char buf[4]{};
+        REQUIRE_EQ(read(side_channel.get_out(), buf, sizeof(buf)), 1);
+        REQUIRE_EQ(std::string_view{buf}, "b");
+        REQUIRE_EQ(cmd.read_extra_output(fd), "a");
+        REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+      }
+    }
+
+    SUBCASE("pipe capacity") {
+      spawn_options options;
+
+      SUBCASE("enlarged") {
+        options.stdout_pipe_capacity = 128 * 1024;
+        exec_path_args cmd{shell_cmd("head -c 100000 /dev/zero",
+                                     std::move(options))};
+
+        // the whole output fits into the pipe, so it doesn't block:
+        REQUIRE_NOTHROW(cmd.finish());
+        REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+        REQUIRE_EQ(cmd.read_stdout(true).size(), std::size_t{100000});
+      }
+
+      SUBCASE("invalid") {
+        options.stderr_pipe_capacity = -1;
+        exec_path_args cmd{shell_cmd("true", std::move(options))};
+        REQUIRE_THROWS(cmd.update_and_get_state());
+      }
+    }
+
+    SUBCASE("environment") {
+      REQUIRE_EQ(setenv("EXEC_PATH_ARGS_TEST_KEPT", "kept", 1), 0);
+      REQUIRE_EQ(setenv("EXEC_PATH_ARGS_TEST_REPLACED", "old", 1), 0);
+      spawn_options options;
+      options.environment = {"EXEC_PATH_ARGS_TEST_REPLACED=new",
+                             "EXEC_PATH_ARGS_TEST_ADDED=a=b"};
+      exec_path_args cmd{shell_cmd("echo \"$EXEC_PATH_ARGS_TEST_KEPT "
+                                   "$EXEC_PATH_ARGS_TEST_REPLACED "
+                                   "$EXEC_PATH_ARGS_TEST_ADDED\"",
+                                   std::move(options))};
+
+      REQUIRE_NOTHROW(cmd.finish());
+      unsetenv("EXEC_PATH_ARGS_TEST_KEPT");
+      unsetenv("EXEC_PATH_ARGS_TEST_REPLACED");
+      REQUIRE_EQ(cmd.read_stdout(true), "kept new a=b\n");
+    }
+
+    SUBCASE("stdin from an fd") {
+      native_fd_t fd{invalid_fd};
+
+      SUBCASE("sealed memfd") {
+        REQUIRE_NOTHROW(fd = sealed_memfd("one\ntwo\n"));
+        // (nobody can change it anymore)
+        REQUIRE_EQ(write(fd, "x", 1), -1);
+      }
+
+      SUBCASE("file") {
+        auto const file{std::filesystem::temp_directory_path() /
+                        ("exec_path_args_stdin_" + std::to_string(getpid()))};
+        FILE *const f{std::fopen(file.c_str(), "w")};
+        REQUIRE_NE(f, nullptr);
+        std::fputs("one\ntwo\n", f);
+        std::fclose(f);
+        fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+        std::filesystem::remove(file);
+        REQUIRE_NE(fd, -1);
+      }
+
+      spawn_options options;
+      options.stdin_fd = fd;
+      exec_path_args cmd{shell_cmd("cat", std::move(options))};
+      REQUIRE_NOTHROW(cmd.update_and_get_state());
+      REQUIRE_THROWS_AS(cmd.send_to_stdin("more"), std::runtime_error);
+      REQUIRE_NOTHROW(cmd.finish());
+      close(fd); // (still the parent's)
+      REQUIRE_EQ(cmd.read_stdout(true), "one\ntwo\n");
+      REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+    }
+
+    SUBCASE("invalid options are refused before spawning") {
+      spawn_options options;
+
+      SUBCASE("CPU") { options.cpu_affinity = {-1}; }
+
+      SUBCASE("NUMA node") {
+        options.numa_policy = spawn_options::memory_policy::interleave;
+        options.numa_nodes = {1'000'000};
+      }
+
+      SUBCASE("NUMA policy without nodes") {
+        options.numa_policy = spawn_options::memory_policy::preferred;
+      }
+
+      SUBCASE("I/O priority level") {
+        options.io_priority = spawn_options::io_priority_class::realtime;
+        options.io_priority_level = 8;
+      }
+
+      SUBCASE("extra fd overriding stderr") { options.extra_fds = {{2}}; }
+
+      SUBCASE("duplicate extra fd") { options.extra_fds = {{3}, {3}}; }
+
+      SUBCASE("environment entry") { options.environment = {"NO_VALUE"}; }
+
+      SUBCASE("stdin fd") { options.stdin_fd = -2; }
+
+      exec_path_args cmd{shell_cmd("exit 0", std::move(options))};
+
+      REQUIRE_NE(spawn_error(cmd).find("invalid spawn options"),
+                 std::string::npos);
+    }
+
+    SUBCASE("failure in child is reported back") {
+      spawn_options options;
+      options.cpu_affinity = {CPU_SETSIZE - 1}; // hopefully not present ...
+      exec_path_args cmd{shell_cmd("exit 0", std::move(options))};
+
+      REQUIRE_NE(spawn_error(cmd).find("`sched_setaffinity` failed - errno " +
+                                       std::to_string(EINVAL)),
+                 std::string::npos);
+    }
+
+    SUBCASE("failing `execv` is reported back") {
+      exec_path_args cmd{"/non/existent/binary", {}, spawn_options{}};
+
+      REQUIRE_NE(spawn_error(cmd).find("`execv` failed - errno " +
+                                       std::to_string(ENOENT)),
+                 std::string::npos);
+    }
+  }
 }
 
 } // namespace
@@ -0,0 +1,92 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/kill_all.hxx"
+
+#include <sys/wait.h>
+
+#include <cerrno>
+#include <csignal>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "impl/reaper.hxx"
+
+namespace exec_path_args::os_wrapper {
+namespace {
+
+[[nodiscard]] std::vector<exec_path_args> spawn_sleepers(int const count) {
+  std::vector<exec_path_args> cmds;
+  for (int i{0}; i < count; ++i) {
+    cmds.emplace_back("/usr/bin/env", std::vector<std::string>{"sleep", "10"});
+    REQUIRE_NOTHROW(cmds.back().update_and_get_state());
+  }
+  return cmds;
+}
+
+[[nodiscard]] bool was_reaped(process_handle_t const pid) {
+  siginfo_t status{};
+  return (waitid(P_PID, pid, &status, WEXITED | WNOHANG | WNOWAIT) == -1) &&
+         (errno == ECHILD);
+}
+
+TEST_CASE("kill_all") {
+  auto cmds{spawn_sleepers(8)};
+  cmds[2].do_kill();          // already finished
+  cmds[5] = exec_path_args{}; // not even initialized
+
+  REQUIRE_NOTHROW(kill_all(cmds));
+
+  for (int i{0}; i < static_cast<int>(cmds.size()); ++i) {
+    if (i == 5) {
+      REQUIRE_FALSE(cmds[i].manages_process());
+      continue;
+    }
+    REQUIRE(cmds[i].is_finished());
+    REQUIRE(was_reaped(cmds[i].get_process_handle()));
+    REQUIRE_EQ(cmds[i].get_exit_reason(), exec_path_args::exit_reason::killed);
+    REQUIRE_EQ(cmds[i].get_return_code(), SIGKILL);
+  }
+}
+
+TEST_CASE("abandoned children are reaped asynchronously") {
+  std::vector<process_handle_t> pids;
+  {
+    auto cmds{spawn_sleepers(8)};
+    for (auto const &cmd : cmds) {
+      pids.push_back(cmd.get_process_handle());
+    }
+  } // destroyed while running
+
+  for (int i{0}; (i < 1000) && (reaper::instance().pending() != 0); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  REQUIRE_EQ(reaper::instance().pending(), 0u);
+  for (auto const pid : pids) {
+    REQUIRE(was_reaped(pid));
+  }
+}
+
+} // namespace
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,101 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/latency_histogram.hxx"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace exec_path_args::os_wrapper {
+namespace {
+
+TEST_CASE("latency_histogram") {
+  // (too big for the stack of a test)
+  auto const histogram{std::make_unique<latency_histogram>()};
+  auto &h{*histogram};
+
+  SUBCASE("empty") {
+    REQUIRE_EQ(h.count(), 0u);
+    REQUIRE_EQ(h.quantile(0.5), 0);
+    REQUIRE_EQ(h.mean(), 0.0);
+    REQUIRE(h.buckets().empty());
+  }
+
+  SUBCASE("small values are exact") {
+    for (long long v{0}; v < 64; ++v) {
+      h.record(v);
+    }
+    REQUIRE_EQ(h.count(), 64u);
+    REQUIRE_EQ(h.min(), 0);
+    REQUIRE_EQ(h.max(), 63);
+    REQUIRE_EQ(h.quantile(0.0), 0);
+    REQUIRE_EQ(h.quantile(0.5), 31);
+    REQUIRE_EQ(h.quantile(1.0), 63);
+    REQUIRE_EQ(h.mean(), 31.5);
+    REQUIRE_EQ(h.buckets().size(), 64u);
+  }
+
+  SUBCASE("quantiles within the relative error") {
+    std::vector<long long> samples;
+    std::uint64_t lcg{1};
+    for (int i{0}; i < 100'000; ++i) {
+      lcg = lcg * 6364136223846793005ull + 1442695040888963407ull;
+      // log-uniformly from 1 us up to ~1 s
+      auto const v{1000LL << ((lcg >> 60) % 20) | ((lcg >> 20) % 1000)};
+      samples.push_back(v);
+      h.record(v);
+    }
+    std::sort(samples.begin(), samples.end());
+    for (double const q : {0.01, 0.5, 0.9, 0.99, 0.999}) {
+      auto const exact{
+          samples[static_cast<std::size_t>(q * samples.size()) - 1]};
+      auto const estimate{h.quantile(q)};
+      REQUIRE_LE(exact, estimate);
+      REQUIRE_LE(estimate - exact, exact / latency_histogram::sub_buckets);
+    }
+    REQUIRE_EQ(h.quantile(1.0), samples.back());
+  }
+
+  SUBCASE("merging & clamping") {
+    auto const other{std::make_unique<latency_histogram>()};
+    h.record(-5);
+    other->record(1'000'000);
+    other->record(latency_histogram::max_value * 2);
+    h.merge(*other);
+    REQUIRE_EQ(h.count(), 3u);
+    REQUIRE_EQ(h.min(), 0);
+    REQUIRE_EQ(h.max(), latency_histogram::max_value);
+
+    auto const buckets{h.buckets()};
+    REQUIRE_EQ(buckets.size(), 3u);
+    REQUIRE_LE(buckets[1].lowest_ns, 1'000'000);
+    REQUIRE_LE(1'000'000, buckets[1].highest_ns);
+    REQUIRE_EQ(buckets[2].highest_ns, latency_histogram::max_value);
+
+    h.reset();
+    REQUIRE_EQ(h.count(), 0u);
+  }
+}
+
+} // namespace
+} // namespace exec_path_args::os_wrapper
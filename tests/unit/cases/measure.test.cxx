@@ -0,0 +1,123 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/measure.hxx"
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "exec_path_args/exec_path_args.hxx"
+
+namespace exec_path_args::os_wrapper {
+namespace {
+
+TEST_CASE("measure") {
+  std::string const some_cli_app{
+      (std::filesystem::current_path() / "build/tests/unit/some_cli_app")
+          .string()};
+
+  auto const ordered = [](measurement::summary const &s) {
+    return (s.min <= s.median) && (s.median <= s.p95) && (s.p95 <= s.p99) &&
+           (s.p99 <= s.max) && (s.min <= s.mean) && (s.mean <= s.max) &&
+           (0.0 <= s.stddev);
+  };
+
+  SUBCASE("wall & cpu time") {
+    auto const m{measure(some_cli_app, {"--sleep", "20"}, 5, 1)};
+    REQUIRE_EQ(m.runs.size(), 5u);
+    for (auto const &run : m.runs) {
+      REQUIRE_GE(run.wall_ns, 20'000'000);
+      REQUIRE_EQ(run.return_code, 0);
+    }
+    REQUIRE(ordered(m.wall_ms));
+    REQUIRE(ordered(m.user_cpu_ms));
+    REQUIRE(ordered(m.system_cpu_ms));
+    REQUIRE_GE(m.wall_ms.min, 20.0);
+    // it sleeps, so it burns (much) less CPU than it takes
+    REQUIRE_LT(m.user_cpu_ms.mean + m.system_cpu_ms.mean, m.wall_ms.mean);
+    REQUIRE_LE(m.wall_outliers, m.runs.size());
+  }
+
+  SUBCASE("max rss") {
+    auto const small{measure(some_cli_app, {"--exit", "0"}, 2)};
+    auto const big{measure(some_cli_app, {"--ballast", "64"}, 2)};
+    REQUIRE(ordered(big.max_rss_kib));
+    REQUIRE_GT(small.max_rss_kib.min, 0.0);
+    REQUIRE_GE(big.max_rss_kib.min, small.max_rss_kib.max + 64 * 1024 - 1024);
+  }
+
+  SUBCASE("output") {
+    // (much more than fits into a pipe)
+    std::vector<std::string> const flood{"--flood-stdout", "4194304"};
+    REQUIRE_EQ(measure(some_cli_app, flood, 2).runs.size(), 2u);
+    measure_options options;
+    options.discard_output = false;
+    REQUIRE_EQ(measure(some_cli_app, flood, 2, 0, options).runs.size(), 2u);
+
+    spawn_options discarding;
+    discarding.discard_output = true;
+    exec_path_args cmd{std::string{some_cli_app},
+                       {"--stdout", "lost", "--stderr", "too"},
+                       std::move(discarding)};
+    cmd.finish();
+    REQUIRE(cmd.read_stdout(true).empty());
+    REQUIRE(cmd.read_stderr(true).empty());
+  }
+
+  SUBCASE("pinned") {
+    measure_options options;
+    options.spawn.cpu_affinity = {0};
+    auto const m{measure(some_cli_app, {"--exit", "0"}, 3, 0, options)};
+    REQUIRE_EQ(m.runs.size(), 3u);
+    REQUIRE_LE(m.wall_outliers, 3u);
+  }
+
+  SUBCASE("failures") {
+    REQUIRE_THROWS_AS(measure(some_cli_app, {"--exit", "3"}, 2),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(measure(some_cli_app, {}, 0), std::runtime_error);
+    REQUIRE_THROWS_AS(measure(some_cli_app, {}, 1, -1), std::runtime_error);
+    REQUIRE_THROWS_AS(measure("/non/existent", {}, 1), std::runtime_error);
+
+    measure_options options;
+    options.ignore_failures = true;
+    auto const m{measure(some_cli_app, {"--exit", "3"}, 2, 1, options)};
+    REQUIRE_EQ(m.runs.size(), 2u);
+    REQUIRE_EQ(m.runs[0].return_code, 3);
+    REQUIRE_EQ(m.runs[1].return_code, 3);
+  }
+
+  SUBCASE("resource usage of a single child") {
+    exec_path_args cmd{std::string{some_cli_app}, {"--exit", "0"}};
+    REQUIRE_THROWS_AS(static_cast<void>(cmd.get_resource_usage()),
+                      std::runtime_error);
+    cmd.finish();
+    auto const usage{cmd.get_resource_usage()};
+    REQUIRE_GE(usage.user_cpu_ns, 0);
+    REQUIRE_GE(usage.system_cpu_ns, 0);
+    REQUIRE_GT(usage.max_rss_kib, 0);
+  }
+}
+
+} // namespace
+} // namespace exec_path_args::os_wrapper
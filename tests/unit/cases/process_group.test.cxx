@@ -0,0 +1,553 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/process_group.hxx"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <csignal>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "exec_path_args/sealed_memfd.hxx"
+#include "impl/reaper.hxx"
+
+namespace exec_path_args::os_wrapper {
+namespace {
+
+using index_t = process_group::index_t;
+
+[[nodiscard]] index_t add_shell(process_group &group, std::string const &cmd,
+                                spawn_options &&options = {}) {
+  return group.add("/usr/bin/env", {"sh", "-c", cmd}, std::move(options));
+}
+
+TEST_CASE("process_group") {
+  process_group group;
+
+  SUBCASE("happy path") {
+    static index_t constexpr count{20};
+    for (index_t i{0}; i < count; ++i) {
+      auto const idx{add_shell(group, "echo " + std::to_string(i) +
+                                          "; echo err >&2; exit " +
+                                          std::to_string(i % 4))};
+      REQUIRE_EQ(idx, i);
+      REQUIRE_EQ(group.get_state(idx), process_group::state::ready);
+    }
+    REQUIRE_EQ(group.size(), count);
+
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_EQ(group.running() + group.finished_indices().size(), count);
+
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_EQ(group.running(), 0u);
+    REQUIRE_NOTHROW(group.collect_outputs());
+
+    auto const finished{group.finished_indices()};
+    REQUIRE_EQ(finished.size(), count);
+    for (index_t i{0}; i < count; ++i) {
+      REQUIRE_EQ(finished[i], i);
+      REQUIRE_EQ(group.get_state(i), process_group::state::finished);
+      REQUIRE_EQ(group.get_return_code(i), static_cast<int>(i % 4));
+      REQUIRE_EQ(group.get_exit_reason(i), process_group::exit_reason::exited);
+      REQUIRE_EQ(group.read_stdout(i), std::to_string(i) + '\n');
+      REQUIRE_EQ(group.get_stderr(i), "err\n");
+      REQUIRE_EQ(group.read_stderr(i), "");
+      REQUIRE_LE(0.0, group.time_running_ms(i));
+    }
+  }
+
+  SUBCASE("spawning only some") {
+    for (int i{0}; i < 10; ++i) {
+      static_cast<void>(add_shell(group, "exit 0"));
+    }
+    REQUIRE(group.spawn_all(4).empty());
+    for (index_t i{0}; i < 10; ++i) {
+      REQUIRE_EQ(group.get_state(i) == process_group::state::ready, 4 <= i);
+    }
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_EQ(group.finished_indices().size(), 10u);
+  }
+
+  SUBCASE("spawn failures") {
+    static_cast<void>(add_shell(group, "exit 0"));
+    static_cast<void>(group.add("/non/existent/binary", {}));
+    spawn_options invalid;
+    invalid.cpu_affinity = {-1};
+    static_cast<void>(add_shell(group, "exit 0", std::move(invalid)));
+    spawn_options captured;
+    captured.extra_fds = {{5}};
+    static_cast<void>(add_shell(group, "exit 0", std::move(captured)));
+
+    auto const failures{group.spawn_all()};
+    REQUIRE_EQ(failures.size(), 3u);
+    for (std::size_t k{0}; k < failures.size(); ++k) {
+      REQUIRE_EQ(failures[k].index, k + 1);
+      REQUIRE_THROWS(std::rethrow_exception(failures[k].error));
+      REQUIRE_EQ(group.get_state(failures[k].index),
+                 process_group::state::ready);
+    }
+
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_EQ(group.get_return_code(0), 0);
+    REQUIRE_THROWS(static_cast<void>(group.get_return_code(1)));
+
+    // retried (& failing again) - unless cancelled
+    REQUIRE_EQ(group.spawn_all().size(), 3u);
+    REQUIRE_NOTHROW(group.cancel(1));
+    REQUIRE_EQ(group.get_state(1), process_group::state::uninitialzied);
+    REQUIRE_THROWS(group.cancel(1));
+    REQUIRE_THROWS(group.cancel(0)); // (already finished)
+    auto const retried{group.spawn_all()};
+    REQUIRE_EQ(retried.size(), 2u);
+    REQUIRE_EQ(retried.front().index, 2u);
+  }
+
+  SUBCASE("spawning only some, despite failures") {
+    for (int i{0}; i < 6; ++i) {
+      if (i % 2 == 0) {
+        static_cast<void>(group.add("/non/existent/binary", {}));
+      } else {
+        static_cast<void>(add_shell(group, "exit 0"));
+      }
+    }
+    // only the successful spawns count:
+    auto const failures{group.spawn_all(2)};
+    REQUIRE_EQ(failures.size(), std::size_t{2});
+    REQUIRE_EQ(failures[0].index, index_t{0});
+    REQUIRE_EQ(failures[1].index, index_t{2});
+    REQUIRE_NE(group.get_state(1), process_group::state::ready);
+    REQUIRE_NE(group.get_state(3), process_group::state::ready);
+    REQUIRE_EQ(group.get_state(5), process_group::state::ready);
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_EQ(group.get_return_code(3), EXIT_SUCCESS);
+  }
+
+  SUBCASE("killing") {
+    for (int i{0}; i < 6; ++i) {
+      static_cast<void>(add_shell(group, "exec sleep 10"));
+    }
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_EQ(group.update_all(0), 0u);
+
+    REQUIRE_NOTHROW(group.kill(2));
+    REQUIRE_EQ(group.get_state(2), process_group::state::finished);
+    REQUIRE_EQ(group.running(), 5u);
+
+    REQUIRE_NOTHROW(group.kill_all());
+    REQUIRE_EQ(group.running(), 0u);
+    for (index_t i{0}; i < 6; ++i) {
+      REQUIRE_EQ(group.get_exit_reason(i), process_group::exit_reason::killed);
+      REQUIRE_EQ(group.get_return_code(i), SIGKILL);
+    }
+  }
+
+  SUBCASE("deadlines") {
+    auto const fast{add_shell(group, "exit 3")};
+    auto const slow{add_shell(group, "exec sleep 10")};
+    // ignored signals stay ignored across `execv`
+    auto const stubborn{add_shell(group, "trap '' TERM; exec sleep 10")};
+    auto const cancelled{add_shell(group, "sleep 0.2")};
+    for (auto const i : {fast, slow, stubborn, cancelled}) {
+      REQUIRE_NOTHROW(group.set_deadline(i, 50, 50));
+    }
+    REQUIRE_THROWS(group.set_deadline(fast, -1));
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.cancel_deadline(cancelled));
+
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_EQ(group.get_exit_reason(fast), process_group::exit_reason::exited);
+    REQUIRE_EQ(group.get_return_code(fast), 3);
+    REQUIRE_EQ(group.get_exit_reason(slow),
+               process_group::exit_reason::timed_out);
+    REQUIRE_EQ(group.get_return_code(slow), SIGTERM);
+    REQUIRE_EQ(group.get_exit_reason(stubborn),
+               process_group::exit_reason::timed_out);
+    REQUIRE_EQ(group.get_return_code(stubborn), SIGKILL);
+    REQUIRE_LE(100.0, group.time_running_ms(stubborn));
+    REQUIRE_EQ(group.get_exit_reason(cancelled),
+               process_group::exit_reason::exited);
+    REQUIRE_THROWS(group.set_deadline(fast, 10));
+  }
+
+  SUBCASE("deadline of a running child") {
+    auto const i{add_shell(group, "exec sleep 10")};
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_EQ(group.update_all(20), 0u);
+    REQUIRE_NOTHROW(group.set_deadline(i, 0));
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_EQ(group.get_exit_reason(i), process_group::exit_reason::timed_out);
+  }
+
+  SUBCASE("inactivity timeouts") {
+    auto const silent{add_shell(group, "echo hi; exec sleep 10")};
+    auto const chatty{
+        add_shell(group, "while :; do echo tick; sleep 0.02; done")};
+    auto const both{add_shell(group, "exec sleep 10")};
+    REQUIRE_NOTHROW(group.set_inactivity_timeout(silent, 50, 50));
+    REQUIRE_NOTHROW(group.set_inactivity_timeout(chatty, 300));
+    REQUIRE_NOTHROW(group.set_inactivity_timeout(both, 1000));
+    REQUIRE_NOTHROW(group.set_deadline(both, 50)); // (sooner)
+    REQUIRE(group.spawn_all().empty());
+
+    while (group.get_state(silent) == process_group::state::running) {
+      static_cast<void>(group.update_all(-1));
+    }
+    REQUIRE_EQ(group.get_exit_reason(silent),
+               process_group::exit_reason::inactive);
+    REQUIRE_EQ(group.get_return_code(silent), SIGTERM);
+    REQUIRE_EQ(group.read_stdout(silent), "hi\n");
+    REQUIRE_LE(50.0, group.time_running_ms(silent));
+
+    while (group.get_state(both) == process_group::state::running) {
+      static_cast<void>(group.update_all(-1));
+    }
+    REQUIRE_EQ(group.get_exit_reason(both),
+               process_group::exit_reason::timed_out);
+
+    // way past its timeout, but never silent for that long
+    while (group.time_running_ms(chatty) < 600) {
+      static_cast<void>(group.update_all(10));
+    }
+    REQUIRE_EQ(group.get_state(chatty), process_group::state::running);
+    REQUIRE_NOTHROW(group.cancel_inactivity_timeout(chatty));
+    REQUIRE_NOTHROW(group.kill_all());
+    REQUIRE_EQ(group.get_exit_reason(chatty),
+               process_group::exit_reason::killed);
+  }
+
+  SUBCASE("inactivity timeout & deadline") {
+    // inactive first, but its (long) grace period doesn't postpone the
+    // deadline - which then `SIGKILL`s it, as `SIGTERM` is ignored
+    auto const idx{add_shell(group, "trap '' TERM; exec sleep 10")};
+    REQUIRE_NOTHROW(group.set_inactivity_timeout(idx, 50, 5000));
+    REQUIRE_NOTHROW(group.set_deadline(idx, 300));
+    REQUIRE(group.spawn_all().empty());
+
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_EQ(group.get_exit_reason(idx),
+               process_group::exit_reason::inactive);
+    REQUIRE_EQ(group.get_return_code(idx), SIGKILL);
+    REQUIRE_LE(300.0, group.time_running_ms(idx));
+    REQUIRE_LT(group.time_running_ms(idx), 2000.0);
+  }
+
+  SUBCASE("stats") {
+    group.enable_stats();
+    for (int i{0}; i < 5; ++i) {
+      static_cast<void>(group.add("/usr/bin/env", {"echo", "hi"}));
+    }
+    auto const silent{add_shell(group, "exit 0")};
+    group.set_template(silent, "silent");
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_NOTHROW(group.collect_outputs());
+
+    auto const stats{group.stats()};
+    REQUIRE_EQ(stats.size(), 2u);
+    auto const &echo{stats.at("/usr/bin/env")};
+    REQUIRE_EQ(echo.spawn_ns.count(), 5u);
+    REQUIRE_EQ(echo.first_output_ns.count(), 5u);
+    REQUIRE_EQ(echo.runtime_ns.count(), 5u);
+    REQUIRE_LT(0, echo.spawn_ns.quantile(0.99));
+    REQUIRE_LE(echo.runtime_ns.min(), echo.runtime_ns.quantile(0.5));
+    REQUIRE_EQ(stats.at("silent").first_output_ns.count(), 0u);
+    REQUIRE_EQ(stats.at("silent").runtime_ns.count(), 1u);
+  }
+
+  SUBCASE("sampling") {
+    auto const before{add_shell(group, "sleep 0.1")};
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_THROWS(group.enable_sampling(0));
+    REQUIRE_THROWS(group.enable_sampling(10, 0));
+    group.enable_sampling(20, 4);
+    auto const sleeping{add_shell(group, "sleep 0.3")};
+    auto const busy{add_shell(
+        group, "i=0; while [ $i -lt 300000 ]; do i=$((i + 1)); done")};
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.finish_all());
+
+    REQUIRE(group.samples(before).empty());
+    for (auto const i : {sleeping, busy}) {
+      auto const samples{group.samples(i)};
+      REQUIRE_EQ(samples.size(), 4u); // (only the last ones kept)
+      for (std::size_t k{0}; k < samples.size(); ++k) {
+        REQUIRE_LT(0, samples[k].rss_kib);
+        REQUIRE_LE(samples[k].rss_kib, samples[k].vm_size_kib);
+        if (k > 0) {
+          REQUIRE_LT(samples[k - 1].since_spawn_ns, samples[k].since_spawn_ns);
+          REQUIRE_LE(samples[k - 1].cpu_ns, samples[k].cpu_ns);
+        }
+      }
+      REQUIRE_GE(samples.back().since_spawn_ns, 80'000'000);
+    }
+    // (the busy one runs on the CPU all the time)
+    REQUIRE_LT(0, group.samples(busy).back().cpu_ns);
+  }
+
+  SUBCASE("stdin") {
+    auto const i{group.add("/usr/bin/env", {"cat"})};
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.send_to_stdin(i, "hello "));
+    REQUIRE_NOTHROW(group.send_to_stdin(i, "there"));
+    REQUIRE_NOTHROW(group.close_stdin(i));
+    REQUIRE_THROWS(group.send_to_stdin(i, "!"));
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_NOTHROW(group.collect_outputs());
+    REQUIRE_EQ(group.read_stdout(i), "hello there");
+  }
+
+  SUBCASE("stdin pieces & partial writes") {
+    auto const i{group.add("/usr/bin/env", {"cat"})};
+    auto const j{add_shell(group, "sleep 0.3; cat > /dev/null")};
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.send_to_stdin(i, {"hello", " ", "there"}));
+    REQUIRE_NOTHROW(group.close_stdin(i));
+
+    std::string const big(4 * 1024 * 1024, 'b');
+    std::size_t accepted{0};
+    REQUIRE_NOTHROW(accepted = group.try_send_to_stdin(j, big));
+    REQUIRE_LT(accepted, big.size());
+    REQUIRE_NOTHROW(
+        group.send_to_stdin(j, std::string_view{big}.substr(accepted)));
+    REQUIRE_NOTHROW(group.close_stdin(j));
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_NOTHROW(group.collect_outputs());
+    REQUIRE_EQ(group.read_stdout(i), "hello there");
+    REQUIRE_EQ(group.get_return_code(j), EXIT_SUCCESS);
+  }
+
+  SUBCASE("stdin producer") {
+    // (far more than the pipe holds, so it has to be pulled gradually)
+    static std::size_t constexpr total{4 * 1024 * 1024};
+    std::size_t produced{0};
+    std::size_t max_ahead{0};
+    auto const i{add_shell(group, "wc -c")};
+    REQUIRE_NOTHROW(group.set_stdin_producer(
+        i, [&](char *const buffer, std::size_t const capacity) {
+          auto const n{std::min(capacity, total - produced)};
+          std::fill_n(buffer, n, 'x');
+          produced += n;
+          max_ahead = std::max(max_ahead, n);
+          return n;
+        }));
+    // a child already running, with nothing to produce
+    auto const j{group.add("/usr/bin/env", {"cat"})};
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.set_stdin_producer(
+        j, [](char *const, std::size_t const) -> std::size_t { return 0; }));
+
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_NOTHROW(group.collect_outputs());
+    REQUIRE_EQ(produced, total);
+    // (a single library-provided buffer)
+    REQUIRE_LE(max_ahead, std::size_t{64 * 1024});
+    REQUIRE_EQ(group.read_stdout(i), std::to_string(total) + "\n");
+    REQUIRE_EQ(group.get_return_code(j), EXIT_SUCCESS);
+    REQUIRE_THROWS(group.set_stdin_producer(
+        i, [](char *const, std::size_t const) -> std::size_t { return 0; }));
+
+    spawn_options options;
+    options.stdin_fd = STDIN_FILENO;
+    auto const k{group.add("/usr/bin/env", {"true"}, std::move(options))};
+    REQUIRE_THROWS(group.set_stdin_producer(
+        k, [](char *const, std::size_t const) -> std::size_t { return 0; }));
+  }
+
+  SUBCASE("stdin producer of a child that's gone") {
+    // a byte at a time, never ending
+    auto const trickle = [](char *const buffer, std::size_t const) {
+      buffer[0] = 'x';
+      return std::size_t{1};
+    };
+
+    // its grandchild keeps stdin open (so no `EPOLLERR`) & the pipe has room -
+    // so its exit & its stdin being writable come in the same batch
+    auto const i{add_shell(group, "sleep 0.3 <&0 & exit 0")};
+    REQUIRE_NOTHROW(group.set_stdin_producer(i, trickle));
+    // nobody reads it anymore by the time it's written to - `EPIPE` (no
+    // `SIGPIPE` killing the whole test) ends the stream
+    auto const j{add_shell(group, "exec 0<&-; sleep 0.3")};
+    REQUIRE_NOTHROW(group.set_stdin_producer(
+        j, [](char *const buffer, std::size_t const capacity) {
+          std::this_thread::sleep_for(std::chrono::milliseconds{100});
+          std::fill_n(buffer, capacity, 'x');
+          return capacity;
+        }));
+    REQUIRE(group.spawn_all().empty());
+
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_EQ(group.get_return_code(i), EXIT_SUCCESS);
+    REQUIRE_EQ(group.get_return_code(j), EXIT_SUCCESS);
+  }
+
+  SUBCASE("stdin producer of a child closed earlier in the same batch") {
+    // both stdins are writable right after spawning - reported in the order
+    // they were watched (by index), so `closer`'s producer runs first & the
+    // event of `closed` is still pending then (as if its exit came first)
+    auto const closer{add_shell(group, "cat > /dev/null")};
+    auto const closed{add_shell(group, "cat > /dev/null")};
+    REQUIRE_NOTHROW(group.set_stdin_producer(
+        closer, [&](char *const, std::size_t const) -> std::size_t {
+          if (group.get_state(closed) == process_group::state::running) {
+            group.close_stdin(closed);
+          }
+          return 0;
+        }));
+    REQUIRE_NOTHROW(group.set_stdin_producer(
+        closed, [](char *const buffer, std::size_t const) {
+          buffer[0] = 'x';
+          return std::size_t{1};
+        }));
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_EQ(group.get_return_code(closer), EXIT_SUCCESS);
+    REQUIRE_EQ(group.get_return_code(closed), EXIT_SUCCESS);
+  }
+
+  SUBCASE("fds still held by a forked process") {
+    auto const idx{add_shell(group, "echo done")};
+    REQUIRE(group.spawn_all().empty());
+    // (e.g. another thread spawning something meanwhile - not `exec`ed yet)
+    auto const holder{fork()};
+    REQUIRE_NE(holder, -1);
+    if (holder == 0) {
+      pause();
+      _exit(EXIT_SUCCESS);
+    }
+    REQUIRE_NOTHROW(group.finish_all());
+    // the (still readable) pidfd & pipes must not be reported anymore:
+    REQUIRE_EQ(group.update_all(0), std::size_t{0});
+    REQUIRE_NOTHROW(group.shrink_to_fit());
+    REQUIRE_EQ(group.update_all(0), std::size_t{0});
+    ::kill(holder, SIGKILL);
+    REQUIRE_NE(waitpid(holder, nullptr, 0), -1);
+    REQUIRE_EQ(group.read_stdout(idx), "done\n");
+  }
+
+  SUBCASE("stdin from a sealed memfd") {
+    auto fd{sealed_memfd("no copying through a pipe")};
+    spawn_options options;
+    options.stdin_fd = fd;
+    auto const i{group.add("/usr/bin/env", {"cat"}, std::move(options))};
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_THROWS(group.send_to_stdin(i, "!"));
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_NOTHROW(group.collect_outputs());
+    REQUIRE_EQ(group.read_stdout(i), "no copying through a pipe");
+    close(fd);
+  }
+
+  SUBCASE("outputs are drained while waiting") {
+    // much more than a pipe holds
+    for (int i{0}; i < 4; ++i) {
+      static_cast<void>(add_shell(group, "head -c 1000000 /dev/zero"));
+    }
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_NOTHROW(group.collect_outputs());
+    for (index_t i{0}; i < 4; ++i) {
+      REQUIRE_EQ(group.read_stdout(i).size(), 1000000u);
+    }
+  }
+
+  SUBCASE("output of a running child") {
+    auto const i{add_shell(group, "echo hi; exec sleep 10")};
+    REQUIRE(group.spawn_all().empty());
+    for (int attempt{0}; (attempt < 100) && group.read_stdout(i).empty();
+         ++attempt) {
+      REQUIRE_EQ(group.update_all(10), 0u);
+    }
+    REQUIRE_EQ(group.read_stdout(i), "hi\n");
+    REQUIRE_EQ(group.get_state(i), process_group::state::running);
+    REQUIRE_LE(0.0, group.time_running_ms(i));
+  }
+
+  SUBCASE("destroyed while running") {
+    {
+      process_group other;
+      for (int i{0}; i < 4; ++i) {
+        static_cast<void>(add_shell(other, "exec sleep 10"));
+      }
+      REQUIRE(other.spawn_all().empty());
+
+      // moved around meanwhile:
+      group = std::move(other);
+      REQUIRE_EQ(other.size(), 0u);
+      REQUIRE_EQ(group.running(), 4u);
+      group = process_group{};
+    }
+    for (int i{0}; (i < 1000) && (reaper::instance().pending() != 0); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    REQUIRE_EQ(reaper::instance().pending(), 0u);
+  }
+
+  SUBCASE("many entries") {
+    static int constexpr count{100'000};
+    group.reserve(count);
+    for (int i{0}; i < count; ++i) {
+      static_cast<void>(group.add("/bin/true", {}));
+    }
+    REQUIRE_EQ(group.size(), count);
+    REQUIRE(group.finished_indices().empty());
+    REQUIRE_EQ(group.update_all(0), 0u);
+    REQUIRE_EQ(group.get_state(count - 1), process_group::state::ready);
+  }
+
+  SUBCASE("shared options & shrinking") {
+    auto const options{std::make_shared<spawn_options const>()};
+    for (int i{0}; i < 8; ++i) {
+      static_cast<void>(group.add(
+          "/usr/bin/env", {"sh", "-c", "printf " + std::to_string(i)},
+          options));
+    }
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_NOTHROW(group.shrink_to_fit());
+
+    for (index_t i{0}; i < 8; ++i) {
+      REQUIRE_EQ(group.read_stdout(i), std::to_string(i));
+      REQUIRE_EQ(group.get_return_code(i), 0);
+    }
+    // still usable afterwards:
+    auto const i{group.add("/usr/bin/env", {"echo", "again"})};
+    REQUIRE(group.spawn_all().empty());
+    REQUIRE_NOTHROW(group.finish_all());
+    REQUIRE_NOTHROW(group.collect_outputs());
+    REQUIRE_EQ(group.read_stdout(i), "again\n");
+  }
+
+  SUBCASE("invalid index") {
+    REQUIRE_THROWS(static_cast<void>(group.get_state(0)));
+    REQUIRE_THROWS(group.kill(0));
+  }
+}
+
+} // namespace
+} // namespace exec_path_args::os_wrapper
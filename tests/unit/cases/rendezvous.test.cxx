@@ -0,0 +1,122 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/rendezvous.hxx"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <doctest/doctest.h>
+
+#include "exec_path_args/exec_path_args.hxx"
+
+namespace exec_path_args::os_wrapper {
+namespace {
+
+TEST_CASE("rendezvous") {
+  std::string const some_cli_app{
+      (std::filesystem::current_path() / "build/tests/unit/some_cli_app")
+          .string()};
+
+  SUBCASE("within a process") {
+    auto parent{rendezvous::create()};
+    // (another mapping of the same one, as the child would have)
+    auto child{rendezvous::attach(dup(parent.fd()))};
+
+    REQUIRE_FALSE(parent.wait(0)); // (timeout)
+    auto const start{std::chrono::steady_clock::now()};
+    REQUIRE_FALSE(child.wait(50));
+    REQUIRE_GE(std::chrono::steady_clock::now() - start,
+               std::chrono::milliseconds{50});
+
+    // counted - & each side only gets what the other one notifies
+    parent.notify();
+    parent.notify();
+    REQUIRE_FALSE(parent.wait(0));
+    REQUIRE(child.wait(0));
+    REQUIRE(child.wait(0));
+    REQUIRE_FALSE(child.wait(0));
+  }
+
+  SUBCASE("between threads") {
+    auto parent{rendezvous::create()};
+    auto child{rendezvous::attach(dup(parent.fd()))};
+
+    static int constexpr rounds{10'000};
+    std::thread other{[&] {
+      for (int i{0}; i < rounds; ++i) {
+        if (!child.wait_and_notify(5000)) {
+          break;
+        }
+      }
+    }};
+    int completed{0};
+    while ((completed < rounds) && parent.notify_and_wait(5000)) {
+      ++completed;
+    }
+    other.join();
+    REQUIRE_EQ(completed, rounds);
+  }
+
+  SUBCASE("with a child") {
+    auto sync{rendezvous::create()};
+    spawn_options options;
+    sync.pass_to(options, 3);
+    exec_path_args cmd{std::string{some_cli_app},
+                       {"--stdout", "before", "--notify-and-wait", "--stdout",
+                        "after", "--ping-pong", "100"},
+                       std::move(options)};
+    REQUIRE_NOTHROW(cmd.update_and_get_state());
+    REQUIRE(sync.wait(5000));
+    REQUIRE_EQ(cmd.read_stdout(false), "before\n");
+    sync.notify();
+    for (int i{0}; i < 100; ++i) {
+      REQUIRE(sync.notify_and_wait(5000));
+    }
+    REQUIRE_NOTHROW(cmd.finish());
+    REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+    REQUIRE_EQ(cmd.read_stdout(true), "before\nafter\n");
+  }
+
+  SUBCASE("invalid") {
+    REQUIRE_THROWS_AS(rendezvous::attach(dup(STDIN_FILENO)),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(
+        rendezvous::from_environment("EXEC_PATH_ARGS_NO_RENDEZVOUS"),
+        std::runtime_error);
+
+    // the child times out (nobody notifies it back)
+    auto sync{rendezvous::create()};
+    spawn_options options;
+    sync.pass_to(options, 3);
+    exec_path_args cmd{std::string{some_cli_app},
+                       {"--notify-and-wait"},
+                       std::move(options)};
+    REQUIRE_NOTHROW(cmd.finish());
+    REQUIRE_EQ(cmd.get_return_code(), EXIT_FAILURE);
+  }
+}
+
+} // namespace
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,150 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/run_log.hxx"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace exec_path_args::os_wrapper {
+namespace {
+
+using namespace std::string_view_literals;
+
+[[nodiscard]] run_record record_of(int const i) {
+  run_record r{};
+  r.return_code = i % 3;
+  r.start_ns = 1000 * i;
+  r.end_ns = 1000 * i + 500;
+  r.max_rss_kib = i;
+  r.stdout_bytes = static_cast<std::uint64_t>(2 * i);
+  return r;
+}
+
+TEST_CASE("run_log") {
+  auto const path{(std::filesystem::temp_directory_path() /
+                   ("exec_path_args_run_log." + std::to_string(getpid())))
+                      .string()};
+  auto const cleanup = [&] {
+    std::filesystem::remove(path);
+    std::filesystem::remove(path + ".strings");
+  };
+  cleanup();
+
+  SUBCASE("round trip") {
+    {
+      run_log_writer log{path, 1024}; // (small - handed over many times)
+      for (int i{0}; i < 1000; ++i) {
+        log.append("/bin/echo", {"x", std::to_string(i % 10)}, record_of(i));
+      }
+    }
+
+    run_log_reader const log{path};
+    REQUIRE_EQ(log.size(), 1000u);
+    int i{0};
+    for (auto const &r : log) {
+      REQUIRE_EQ(r.return_code, i % 3);
+      REQUIRE_EQ(r.end_ns - r.start_ns, 500);
+      REQUIRE_EQ(r.stdout_bytes, static_cast<std::uint64_t>(2 * i));
+      REQUIRE(log.command_parts_of(r) ==
+              std::vector<std::string_view>{"/bin/echo", "x",
+                                            std::to_string(i % 10)});
+      ++i;
+    }
+    // each distinct command is stored once
+    REQUIRE_EQ(std::filesystem::file_size(path + ".strings"),
+               10 * ("/bin/echo\0x\0"
+                     "0\0"sv)
+                        .size());
+  }
+
+  SUBCASE("appending & flushing") {
+    run_log_writer writer{path};
+    writer.append("/bin/true", {}, record_of(1));
+    writer.flush();
+    {
+      run_log_reader const log{path};
+      REQUIRE_EQ(log.size(), 1u);
+      REQUIRE_EQ(log.command_of(log[0]), "/bin/true\0"sv);
+    }
+
+    {
+      // a partial record (e.g. an interrupted write) is ignored & dropped
+      std::ofstream{path, std::ios::app} << "garbage";
+      REQUIRE_EQ(run_log_reader{path}.size(), 1u);
+      run_log_writer another{path};
+      another.append("/bin/false", {"a b"}, record_of(2));
+    }
+
+    run_log_reader const log{path};
+    REQUIRE_EQ(log.size(), 2u);
+    REQUIRE_EQ(log[1].return_code, 2);
+    REQUIRE(log.command_parts_of(log[1]) ==
+            std::vector<std::string_view>{"/bin/false", "a b"});
+  }
+
+  SUBCASE("concurrent writers") {
+    {
+      run_log_writer log{path, 4096};
+      std::vector<std::thread> threads;
+      for (int t{0}; t < 4; ++t) {
+        threads.emplace_back([&log, t] {
+          for (int i{0}; i < 500; ++i) {
+            log.append("/bin/thread", {std::to_string(t)}, record_of(t));
+          }
+        });
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+    }
+    run_log_reader const log{path};
+    REQUIRE_EQ(log.size(), 2000u);
+    int per_thread[4]{};
+    for (auto const &r : log) {
+      auto const parts{log.command_parts_of(r)};
+      REQUIRE_EQ(parts.size(), 2u);
+      ++per_thread[std::stoi(std::string{parts[1]})];
+    }
+    for (auto const count : per_thread) {
+      REQUIRE_EQ(count, 500);
+    }
+  }
+
+  SUBCASE("not a run log") {
+    REQUIRE_THROWS_AS(run_log_reader{path}, std::runtime_error);
+    std::ofstream{path} << "definitely not a run log, just some text";
+    std::ofstream{path + ".strings"};
+    REQUIRE_THROWS_AS(run_log_reader{path}, std::runtime_error);
+    REQUIRE_THROWS_AS(run_log_writer{path}, std::runtime_error);
+  }
+
+  cleanup();
+}
+
+} // namespace
+} // namespace exec_path_args::os_wrapper
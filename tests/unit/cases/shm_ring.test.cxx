@@ -0,0 +1,185 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/shm_ring.hxx"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <doctest/doctest.h>
+
+#include "exec_path_args/exec_path_args.hxx"
+
+namespace exec_path_args::os_wrapper {
+namespace {
+
+TEST_CASE("shm_ring") {
+  std::string const some_cli_app{
+      (std::filesystem::current_path() / "build/tests/unit/some_cli_app")
+          .string()};
+
+  SUBCASE("within a process") {
+    auto ring{shm_ring::create(1000)};
+    REQUIRE_EQ(ring.capacity() % static_cast<std::size_t>(getpagesize()), 0u);
+    REQUIRE_GE(ring.capacity(), 1000u);
+
+    REQUIRE(ring.readable(0).empty()); // (timeout)
+    REQUIRE(ring.readable(10).empty());
+    REQUIRE_FALSE(ring.eof());
+
+    ring.write_all("hello");
+    REQUIRE_EQ(ring.readable(), "hello");
+    ring.release(2);
+    REQUIRE_EQ(ring.readable(), "llo");
+    ring.release(3);
+
+    // full
+    auto const span{ring.writable()};
+    REQUIRE_EQ(span.size, ring.capacity());
+    ring.commit(span.size);
+    REQUIRE_EQ(ring.writable(10).size, 0u);
+    // (contiguous across the end of the buffer)
+    REQUIRE_EQ(ring.readable().size(), ring.capacity());
+    ring.release(ring.capacity());
+
+    ring.close();
+    REQUIRE(ring.readable().empty());
+    REQUIRE(ring.eof());
+  }
+
+  SUBCASE("corrupted by the other side") {
+    auto ring{shm_ring::create(1000)};
+    ring.write_all("hello");
+    // as e.g. a buggy child could - `head` starts the 2nd cache line
+    auto const page_bytes{static_cast<std::size_t>(getpagesize())};
+    void *const page{mmap(nullptr, page_bytes, PROT_READ | PROT_WRITE,
+                          MAP_SHARED, ring.fd(), 0)};
+    REQUIRE_NE(page, MAP_FAILED);
+    auto &head{static_cast<std::uint64_t *>(page)[8]};
+    REQUIRE_EQ(head, 5u);
+
+    head = 5 * ring.capacity(); // (way ahead of `tail`)
+    REQUIRE_THROWS_AS(static_cast<void>(ring.readable(0)), std::runtime_error);
+    REQUIRE_THROWS_AS(static_cast<void>(ring.writable(0)), std::runtime_error);
+    head = 2; // (behind `tail` once released)
+    REQUIRE_EQ(ring.readable(0), "he");
+    REQUIRE_THROWS_AS(ring.release(3), std::runtime_error);
+    ring.release(2);
+    REQUIRE_THROWS_AS(ring.commit(ring.capacity() + 1), std::runtime_error);
+    head = 1;
+    REQUIRE_THROWS_AS(static_cast<void>(ring.readable(0)), std::runtime_error);
+
+    munmap(page, page_bytes);
+  }
+
+  SUBCASE("between threads") {
+    auto producer_end{shm_ring::create(4096)};
+    // (another mapping of the same ring, as the child would have)
+    auto consumer_end{shm_ring::attach(dup(producer_end.fd()))};
+
+    static long long constexpr total{10'000'000};
+    std::thread producer{[&] {
+      long long i{0};
+      while (i < total) {
+        auto const span{producer_end.writable()};
+        auto const n{
+            std::min<long long>(static_cast<long long>(span.size), total - i)};
+        for (long long k{0}; k < n; ++k) {
+          span.data[k] = static_cast<char>((i + k) % 251);
+        }
+        producer_end.commit(static_cast<std::size_t>(n));
+        i += n;
+      }
+      producer_end.close();
+    }};
+
+    long long received{0};
+    bool intact{true};
+    for (auto data{consumer_end.readable()}; !data.empty();
+         data = consumer_end.readable()) {
+      for (auto const c : data) {
+        intact = intact && (c == static_cast<char>(received++ % 251));
+      }
+      consumer_end.release(data.size());
+    }
+    producer.join();
+    REQUIRE(intact);
+    REQUIRE_EQ(received, total);
+    REQUIRE(consumer_end.eof());
+  }
+
+  SUBCASE("with a child") {
+    auto from_child{shm_ring::create(64 * 1024)};
+    spawn_options options;
+    from_child.pass_to(options, 3);
+    exec_path_args cmd{std::string{some_cli_app},
+                       {"--ring-flood", "1000000"},
+                       std::move(options)};
+    REQUIRE_NOTHROW(cmd.update_and_get_state());
+
+    long long received{0};
+    bool intact{true};
+    for (auto data{from_child.readable(5000)}; !data.empty();
+         data = from_child.readable(5000)) {
+      for (auto const c : data) {
+        intact = intact && (c == static_cast<char>(received++ % 251));
+      }
+      from_child.release(data.size());
+    }
+    REQUIRE_NOTHROW(cmd.finish());
+    REQUIRE_EQ(cmd.get_return_code(), EXIT_SUCCESS);
+    REQUIRE(from_child.eof());
+    REQUIRE(intact);
+    REQUIRE_EQ(received, 1'000'000);
+
+    auto to_child{shm_ring::create(4096)};
+    spawn_options sink_options;
+    to_child.pass_to(sink_options, 5, "SOME_OTHER_NAME");
+    sink_options.environment.push_back(
+        std::string{shm_ring::default_variable} + "=5");
+    exec_path_args sink{std::string{some_cli_app},
+                        {"--ring-sink"},
+                        std::move(sink_options)};
+    REQUIRE_NOTHROW(sink.update_and_get_state());
+    to_child.write_all(std::string(100'000, 'x'));
+    to_child.close();
+    REQUIRE_NOTHROW(sink.finish());
+    REQUIRE_EQ(sink.read_stdout(true), "100000\n");
+  }
+
+  SUBCASE("invalid") {
+    REQUIRE_THROWS_AS(shm_ring::attach(dup(STDIN_FILENO)),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(shm_ring::from_environment("EXEC_PATH_ARGS_NO_RING"),
+                      std::runtime_error);
+
+    exec_path_args cmd{std::string{some_cli_app}, {"--ring-flood", "1"}};
+    REQUIRE_NOTHROW(cmd.finish());
+    REQUIRE_EQ(cmd.get_return_code(), EXIT_FAILURE); // (no ring passed)
+  }
+}
+
+} // namespace
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,99 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/spawn_batch.hxx"
+
+#include <cstdlib>
+
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace exec_path_args::os_wrapper {
+namespace {
+
+TEST_CASE("spawn_batch") {
+  static int constexpr count{24};
+
+  std::vector<exec_path_args> cmds;
+  for (int i{0}; i < count; ++i) {
+    cmds.emplace_back("/usr/bin/env",
+                      std::vector<std::string>{
+                          "sh", "-c", "echo " + std::to_string(i) + "; exit " +
+                                          std::to_string(i % 3)});
+  }
+
+  int num_threads{1};
+  SUBCASE("single thread") { num_threads = 1; }
+  SUBCASE("multiple threads") { num_threads = 5; }
+  SUBCASE("more threads than commands") { num_threads = 2 * count; }
+
+  SUBCASE("all succeed") {
+    auto const results{spawn_batch(cmds, num_threads)};
+
+    REQUIRE_EQ(results.size(), cmds.size());
+    for (int i{0}; i < count; ++i) {
+      REQUIRE_FALSE(results[i]);
+      REQUIRE(cmds[i].manages_process());
+      REQUIRE_NOTHROW(cmds[i].finish());
+      REQUIRE_EQ(cmds[i].read_stdout(true), std::to_string(i) + '\n');
+      REQUIRE_EQ(cmds[i].get_return_code(), i % 3);
+    }
+  }
+
+  SUBCASE("per-item failures") {
+    cmds[3] = exec_path_args{"/non/existent/binary", {}};
+    cmds[7] = exec_path_args{};                         // not ready
+    REQUIRE_NOTHROW(cmds[11].update_and_get_state());   // already running
+    spawn_options invalid;
+    invalid.cpu_affinity = {-1};
+    cmds[13] = exec_path_args{"/usr/bin/env", {"true"}, std::move(invalid)};
+
+    auto const results{spawn_batch(cmds, num_threads)};
+
+    REQUIRE_EQ(results.size(), cmds.size());
+    for (int i{0}; i < count; ++i) {
+      if ((i == 3) || (i == 7) || (i == 11) || (i == 13)) {
+        REQUIRE(results[i]);
+        REQUIRE_THROWS(std::rethrow_exception(results[i]));
+      } else {
+        REQUIRE_FALSE(results[i]);
+      }
+    }
+
+    REQUIRE_FALSE(cmds[3].manages_process());
+    REQUIRE_FALSE(cmds[7].manages_process());
+    REQUIRE_FALSE(cmds[13].manages_process());
+
+    // the already running one wasn't affected:
+    REQUIRE_NOTHROW(cmds[11].finish());
+    REQUIRE_EQ(cmds[11].read_stdout(true), "11\n");
+
+    REQUIRE_NOTHROW(cmds[12].finish());
+    REQUIRE_EQ(cmds[12].read_stdout(true), "12\n");
+  }
+
+  SUBCASE("empty") {
+    REQUIRE(spawn_batch(nullptr, 0, num_threads).empty());
+  }
+}
+
+} // namespace
+} // namespace exec_path_args::os_wrapper
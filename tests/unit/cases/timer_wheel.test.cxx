@@ -0,0 +1,128 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "impl/timer_wheel.hxx"
+
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace exec_path_args::os_wrapper {
+namespace {
+
+using tick_t = timer_wheel::tick_t;
+
+TEST_CASE("timer_wheel") {
+  timer_wheel wheel;
+  std::vector<timer_wheel::timer_id> expired;
+  auto const record = [&](timer_wheel::timer_id const id) {
+    expired.push_back(id);
+  };
+
+  SUBCASE("basics") {
+    REQUIRE_EQ(wheel.ticks_until_next(), -1);
+    wheel.arm(0, 10);
+    wheel.arm(1, 5);
+    wheel.arm(2, 300);
+    wheel.arm(3, 70'000);
+    wheel.arm(4, 0); // in the past -> the very next tick
+    REQUIRE_EQ(wheel.size(), 5u);
+    REQUIRE_EQ(wheel.ticks_until_next(), 1);
+
+    wheel.cancel(0);
+    wheel.cancel(0); // no-op
+    REQUIRE_FALSE(wheel.armed(0));
+    REQUIRE(wheel.armed(1));
+
+    wheel.advance(4, record);
+    REQUIRE(expired == std::vector<timer_wheel::timer_id>{4});
+    wheel.advance(299, record);
+    REQUIRE(expired == std::vector<timer_wheel::timer_id>{4, 1});
+    wheel.advance(300, record);
+    REQUIRE(expired == std::vector<timer_wheel::timer_id>{4, 1, 2});
+    REQUIRE_EQ(wheel.size(), 1u);
+    wheel.advance(1'000'000, record);
+    REQUIRE(expired == std::vector<timer_wheel::timer_id>{4, 1, 2, 3});
+    REQUIRE_EQ(wheel.size(), 0u);
+    REQUIRE_EQ(wheel.now(), 1'000'000);
+  }
+
+  SUBCASE("re-arming, also from the callback") {
+    wheel.arm(7, 100);
+    wheel.arm(7, 50); // moved
+    int fired{0};
+    wheel.advance(1000, [&](timer_wheel::timer_id const id) {
+      REQUIRE_EQ(id, 7u);
+      REQUIRE_EQ(wheel.now(), 50 + 100 * fired);
+      if (++fired < 3) {
+        wheel.arm(id, wheel.now() + 100);
+      }
+    });
+    REQUIRE_EQ(fired, 3);
+  }
+
+  SUBCASE("beyond the horizon") {
+    tick_t const far{(tick_t{1} << 33) + 12'345};
+    wheel.arm(0, far);
+    wheel.advance(far - 1, record);
+    REQUIRE(expired.empty());
+    wheel.advance(far, record);
+    REQUIRE_EQ(expired.size(), 1u);
+  }
+
+  SUBCASE("100k timers, each fires exactly once & on time") {
+    static int constexpr count{100'000};
+    std::vector<tick_t> expiries(count);
+    std::vector<tick_t> fired_at(count, -1);
+
+    std::uint64_t lcg{42};
+    auto const random = [&lcg](tick_t const max) {
+      lcg = lcg * 6364136223846793005ull + 1442695040888963407ull;
+      return static_cast<tick_t>((lcg >> 33) % static_cast<std::uint64_t>(max));
+    };
+
+    for (int i{0}; i < count; ++i) {
+      expiries[i] = 1 + random(10'000'000);
+      wheel.arm(static_cast<timer_wheel::timer_id>(i), expiries[i]);
+    }
+    // every 10th is cancelled again
+    for (int i{0}; i < count; i += 10) {
+      wheel.cancel(static_cast<timer_wheel::timer_id>(i));
+    }
+    REQUIRE_EQ(wheel.size(), static_cast<std::size_t>(count - count / 10));
+
+    bool all_ok{true}; // (not asserting in the hot loop)
+    while (wheel.size() != 0) {
+      wheel.advance(wheel.now() + 1 + random(50'000),
+                    [&](timer_wheel::timer_id const id) {
+                      all_ok = all_ok && (fired_at[id] == -1) &&
+                               (wheel.now() == expiries[id]);
+                      fired_at[id] = wheel.now();
+                    });
+    }
+    REQUIRE(all_ok);
+    for (int i{0}; i < count; ++i) {
+      REQUIRE_EQ(fired_at[i] == -1, i % 10 == 0);
+    }
+  }
+}
+
+} // namespace
+} // namespace exec_path_args::os_wrapper
@@ -0,0 +1,90 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exec_path_args/wait_tuner.hxx"
+
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "exec_path_args/exec_path_args.hxx"
+
+namespace exec_path_args::os_wrapper {
+namespace {
+
+TEST_CASE("wait_tuner") {
+  SUBCASE("templates") {
+    auto const sleep_1{wait_tuner::template_of("/bin/sleep", {"0.1"})};
+    REQUIRE_EQ(sleep_1, wait_tuner::template_of("/bin/sleep", {"0.25"}));
+    REQUIRE_NE(sleep_1, wait_tuner::template_of("/bin/sleep", {"1s"}));
+    REQUIRE_NE(sleep_1, wait_tuner::template_of("/bin/true", {"0.1"}));
+    REQUIRE_NE(wait_tuner::template_of("/bin/echo", {"a", "b"}),
+               wait_tuner::template_of("/bin/echo", {"ab"}));
+  }
+
+  SUBCASE("learning") {
+    wait_tuner tuner{1'000'000, 2};
+    REQUIRE_EQ(tuner.spin_budget_ns(1), 0);
+
+    tuner.record(1, 100'000);
+    REQUIRE_EQ(tuner.spin_budget_ns(1), 200'000);
+    for (int i{0}; i < 20; ++i) {
+      tuner.record(1, 10'000'000); // it got slow
+    }
+    REQUIRE_EQ(tuner.spin_budget_ns(1), 0);
+
+    tuner.record(2, 800'000);
+    REQUIRE_EQ(tuner.spin_budget_ns(2), 1'000'000); // capped
+    tuner.record(3, 1'000);
+    REQUIRE_EQ(tuner.spin_budget_ns(3), 0); // too many templates
+
+    wait_tuner disabled{0};
+    disabled.record(1, 1'000);
+    REQUIRE_EQ(disabled.spin_budget_ns(1), 0);
+  }
+
+  SUBCASE("waiting") {
+    // (spinning explicitly allowed, even on a single CPU)
+    wait_tuner tuner{50'000'000};
+    auto const id{wait_tuner::template_of("/bin/true", {})};
+
+    for (int i{0}; i < 10; ++i) {
+      spawn_options options;
+      options.wait_tuning = &tuner;
+      exec_path_args cmd{"/bin/true", {}, std::move(options)};
+      REQUIRE_NOTHROW(cmd.finish());
+      REQUIRE_EQ(cmd.get_return_code(), 0);
+      REQUIRE_LT(0, tuner.spin_budget_ns(id));
+    }
+
+    // waiting is still bounded by the timeout
+    tuner.record(wait_tuner::template_of("/bin/sleep", {"1"}), 40'000'000);
+    spawn_options options;
+    options.wait_tuning = &tuner;
+    exec_path_args cmd{"/bin/sleep", {"1"}, std::move(options)};
+    REQUIRE_EQ(cmd.update_and_get_state(10).current,
+               exec_path_args::state::running);
+    REQUIRE_LT(cmd.time_running_ms(), 500.0);
+    cmd.do_kill();
+  }
+}
+
+} // namespace
+} // namespace exec_path_args::os_wrapper
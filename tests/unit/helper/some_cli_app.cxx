@@ -17,8 +17,13 @@
   with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <cstdlib>
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <optional>
@@ -32,6 +37,9 @@
 
 #include <ips/ips.hxx>
 
+#include "exec_path_args/rendezvous.hxx"
+#include "exec_path_args/shm_ring.hxx"
+
 namespace {
 
 struct exit_with {
@@ -40,6 +48,10 @@ struct exit_with {
 struct sleep_for_ms {
   int ms;
 };
+// until `ms` since it started (if that's still ahead)
+struct sleep_until_ms {
+  int ms;
+};
 struct echo_stdin_to_stdout {
   int count;
 };
@@ -55,12 +67,53 @@ struct handled_exception {
 struct unhandled_exception {
   inline static std::optional<std::string> msg;
 };
+// through `--sem-name`'s semaphores if given, else the rendezvous passed by
+// the parent (see `exec_path_args::rendezvous`)
 struct notify_and_wait {};
 
+// for benchmarks:
+
+// of the following `flood`s, `0` ~ as fast as possible
+struct set_rate {
+  long long bytes_per_s;
+};
+struct flood {
+  int fd;
+  long long count; // bytes or lines
+  bool lines;      // "line <number>\n" each
+};
+// raw `read`s written back as they come (no `std::cin`/`std::cout` buffering),
+// until EOF
+struct binary_echo {};
+struct ballast {
+  long long mib; // allocated & touched, kept until exiting
+};
+// each just sleeps (keeping the inherited stdout & stderr open) & exits - never
+// waited for
+struct grandchildren {
+  int count;
+  int sleep_ms;
+};
+struct discard_stdin {};
+// through the ring passed by the parent (see `exec_path_args::shm_ring`):
+// `count` bytes, the `i`-th one being `i % 251`, then closes it
+struct ring_flood {
+  long long count;
+};
+// reads it until closed, then prints how many bytes it got
+struct ring_sink {};
+// `count` times waits for the parent & notifies it back (as `notify_and_wait`
+// synchronizes)
+struct ping_pong {
+  int count;
+};
+
 using action_variant =
-    std::variant<exit_with, sleep_for_ms, echo_stdin_to_stdout, to_stdout,
-                 to_stderr, handled_exception, unhandled_exception,
-                 notify_and_wait>;
+    std::variant<exit_with, sleep_for_ms, sleep_until_ms, echo_stdin_to_stdout,
+                 to_stdout, to_stderr, handled_exception, unhandled_exception,
+                 notify_and_wait, set_rate, flood, binary_echo, ballast,
+                 grandchildren, discard_stdin, ring_flood, ring_sink,
+                 ping_pong>;
 
 struct input_exception : public std::exception {
   explicit input_exception(std::string &&aMsg) noexcept
@@ -72,9 +125,143 @@ private:
   std::string msg;
 };
 
+void write_all(int const fd, char const *data, std::size_t size) {
+  while (size != 0) {
+    auto const written{write(fd, data, size)};
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error{"Failed to write output"};
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+// `read`, retried on `EINTR`
+[[nodiscard]] ssize_t read_some(int const fd, char *const data,
+                                std::size_t const size) {
+  ssize_t n;
+  do {
+    n = read(fd, data, size);
+  } while ((n < 0) && (errno == EINTR));
+  return n;
+}
+
+void run_flood(flood const &what, long long const bytes_per_s) {
+  // (whatever is buffered goes first)
+  std::cout.flush();
+  std::cerr.flush();
+
+  static std::size_t constexpr chunk_size{64 * 1024};
+  std::string chunk;
+  chunk.reserve(chunk_size);
+
+  auto const start{std::chrono::steady_clock::now()};
+  long long total_bytes{0};
+  long long emitted{0};
+  while (emitted < what.count) {
+    chunk.clear();
+    if (what.lines) {
+      while ((emitted < what.count) && (chunk.size() + 32 < chunk_size)) {
+        chunk += "line " + std::to_string(emitted++) + '\n';
+      }
+    } else {
+      auto const n{std::min<long long>(what.count - emitted, chunk_size)};
+      chunk.assign(static_cast<std::size_t>(n), 'x');
+      emitted += n;
+    }
+    write_all(what.fd, chunk.data(), chunk.size());
+    total_bytes += static_cast<long long>(chunk.size());
+
+    if (bytes_per_s > 0) {
+      std::this_thread::sleep_until(
+          start + std::chrono::nanoseconds{total_bytes * 1'000'000'000 /
+                                           bytes_per_s});
+    }
+  }
+}
+
+void run_binary_echo() {
+  char buffer[64 * 1024];
+  ssize_t n;
+  while ((n = read_some(STDIN_FILENO, buffer, sizeof(buffer))) > 0) {
+    write_all(STDOUT_FILENO, buffer, static_cast<std::size_t>(n));
+  }
+}
+
+void run_ballast(long long const mib) {
+  static std::vector<std::vector<char>> kept;
+  auto &memory{kept.emplace_back(static_cast<std::size_t>(mib) << 20)};
+  // (in case the allocation is lazily zeroed)
+  auto const page_size{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))};
+  for (std::size_t i{0}; i < memory.size(); i += page_size) {
+    memory[i] = 1;
+  }
+}
+
+void run_grandchildren(grandchildren const &what) {
+  std::cout.flush();
+  std::cerr.flush();
+  for (int i{0}; i < what.count; ++i) {
+    auto const pid{fork()};
+    if (pid < 0) {
+      throw std::runtime_error{"Failed to fork a grandchild"};
+    } else if (pid == 0) {
+      usleep(static_cast<useconds_t>(what.sleep_ms) * 1000);
+      _exit(EXIT_SUCCESS);
+    }
+  }
+}
+
+void run_discard_stdin() {
+  char buffer[64 * 1024];
+  while (read_some(STDIN_FILENO, buffer, sizeof(buffer)) > 0) {
+  }
+}
+
+void run_ring_flood(long long const count) {
+  using exec_path_args::os_wrapper::shm_ring;
+  auto ring{shm_ring::from_environment()};
+
+  static std::size_t constexpr period{251};
+  static std::size_t constexpr chunk_size{64 * 1024};
+  std::string pattern(chunk_size + period, '\0');
+  for (std::size_t i{0}; i < pattern.size(); ++i) {
+    pattern[i] = static_cast<char>(i % period);
+  }
+
+  long long emitted{0};
+  while (emitted < count) {
+    auto const span{ring.writable()};
+    auto const n{std::min<std::size_t>(
+        {span.size, chunk_size, static_cast<std::size_t>(count - emitted)})};
+    std::copy_n(pattern.data() + static_cast<std::size_t>(emitted) % period, n,
+                span.data);
+    ring.commit(n);
+    emitted += static_cast<long long>(n);
+  }
+  ring.close();
+}
+
+void run_ring_sink() {
+  using exec_path_args::os_wrapper::shm_ring;
+  auto ring{shm_ring::from_environment()};
+
+  long long total{0};
+  for (auto data{ring.readable()}; !data.empty(); data = ring.readable()) {
+    total += static_cast<long long>(data.size());
+    ring.release(data.size());
+  }
+  std::cout << total << '\n';
+}
+
 } // namespace
 
 int main(int const argc, char const **argv) try {
+  auto const started{std::chrono::steady_clock::now()};
+
   auto consume_arg = [argc2 = argc - 1, argv2 = argv + 1](
                          bool const require, std::string_view const err_msg =
                                                  "") mutable -> char const * {
@@ -93,6 +280,7 @@ int main(int const argc, char const **argv) try {
 
   std::vector<action_variant> actions;
   std::optional<ips> my_ips;
+  std::optional<exec_path_args::os_wrapper::rendezvous> my_rendezvous;
 
   char const *arg;
   while ((arg = consume_arg(false)) != nullptr) {
@@ -103,6 +291,9 @@ int main(int const argc, char const **argv) try {
     } else if (arg_sv == "--sleep") {
       actions.emplace_back(
           sleep_for_ms{std::stoi(consume_arg(true, "missing sleep duration"))});
+    } else if (arg_sv == "--sleep-until") {
+      actions.emplace_back(sleep_until_ms{
+          std::stoi(consume_arg(true, "missing sleep deadline"))});
     } else if (arg_sv == "--echo") {
       actions.emplace_back(echo_stdin_to_stdout{
           std::stoi(consume_arg(true, "missing echo count"))});
@@ -129,6 +320,35 @@ int main(int const argc, char const **argv) try {
     } else if (arg_sv == "--notify-and-wait") {
       // IMHO more isn't needed right now ...
       actions.emplace_back(notify_and_wait{});
+    } else if (arg_sv == "--rate") {
+      actions.emplace_back(
+          set_rate{std::stoll(consume_arg(true, "missing rate"))});
+    } else if ((arg_sv == "--flood-stdout") || (arg_sv == "--flood-stderr") ||
+               (arg_sv == "--lines-stdout") || (arg_sv == "--lines-stderr")) {
+      actions.emplace_back(
+          flood{arg_sv.substr(arg_sv.size() - 6) == "stdout" ? STDOUT_FILENO
+                                                             : STDERR_FILENO,
+                std::stoll(consume_arg(true, "missing flood size")),
+                arg_sv.substr(2, 5) == "lines"});
+    } else if (arg_sv == "--binary-echo") {
+      actions.emplace_back(binary_echo{});
+    } else if (arg_sv == "--ballast") {
+      actions.emplace_back(
+          ballast{std::stoll(consume_arg(true, "missing ballast size"))});
+    } else if (arg_sv == "--grandchildren") {
+      auto const count{std::stoi(consume_arg(true, "missing grandchildren"))};
+      actions.emplace_back(grandchildren{
+          count, std::stoi(consume_arg(true, "missing grandchild sleep"))});
+    } else if (arg_sv == "--discard-stdin") {
+      actions.emplace_back(discard_stdin{});
+    } else if (arg_sv == "--ring-flood") {
+      actions.emplace_back(
+          ring_flood{std::stoll(consume_arg(true, "missing ring flood size"))});
+    } else if (arg_sv == "--ring-sink") {
+      actions.emplace_back(ring_sink{});
+    } else if (arg_sv == "--ping-pong") {
+      actions.emplace_back(
+          ping_pong{std::stoi(consume_arg(true, "missing ping-pong count"))});
     } else if (arg_sv == "--sem-name") {
       if (my_ips.has_value()) {
         throw input_exception{"Semaphore name already specified"};
@@ -141,15 +361,37 @@ int main(int const argc, char const **argv) try {
     }
   }
 
+  long long bytes_per_s{0};
   for (auto const &action : actions) {
     std::visit(
-        [&my_ips](auto &&arg) {
+        [&my_ips, &my_rendezvous, &bytes_per_s, started](auto &&arg) {
+          // (waiting 1 [s] at most)
+          auto const sync = [&my_ips, &my_rendezvous](bool const notify_first) {
+            if (my_ips.has_value()) {
+              return notify_first ? my_ips->notify_and_wait(1000)
+                                  : my_ips->wait_and_notify(1000);
+            }
+            if (!my_rendezvous.has_value()) {
+              using exec_path_args::os_wrapper::rendezvous;
+              if (std::getenv(rendezvous::default_variable) == nullptr) {
+                throw std::runtime_error{
+                    "Semaphore name not specified for sync operation"};
+              }
+              my_rendezvous.emplace(rendezvous::from_environment());
+            }
+            return notify_first ? my_rendezvous->notify_and_wait(1000)
+                                : my_rendezvous->wait_and_notify(1000);
+          };
+
           using T = std::decay_t<decltype(arg)>;
           if constexpr (std::is_same_v<T, exit_with>) {
             my_ips.reset();
             std::exit(arg.code);
           } else if constexpr (std::is_same_v<T, sleep_for_ms>) {
             std::this_thread::sleep_for(std::chrono::milliseconds{arg.ms});
+          } else if constexpr (std::is_same_v<T, sleep_until_ms>) {
+            std::this_thread::sleep_until(started +
+                                          std::chrono::milliseconds{arg.ms});
           } else if constexpr (std::is_same_v<T, echo_stdin_to_stdout>) {
             std::string str;
             for (int i{0}; i < arg.count; ++i) {
@@ -165,19 +407,36 @@ int main(int const argc, char const **argv) try {
           } else if constexpr (std::is_same_v<T, unhandled_exception>) {
             throw unhandled_exception::msg->c_str();
           } else if constexpr (std::is_same_v<T, notify_and_wait>) {
-            if (!my_ips.has_value()) {
-              throw std::runtime_error{
-                  "Semaphore name not specified for sync operation"};
-            }
-
             // flush pending output before notifying:
             std::cout.flush();
             // should be no-op in this case ... but I'm not sure:
             std::cerr.flush();
 
-            if (!my_ips->notify_and_wait(1000)) { // 1 [s]
+            if (!sync(true)) {
               throw std::runtime_error{"Timeout while waiting for sync"};
             }
+          } else if constexpr (std::is_same_v<T, set_rate>) {
+            bytes_per_s = arg.bytes_per_s;
+          } else if constexpr (std::is_same_v<T, flood>) {
+            run_flood(arg, bytes_per_s);
+          } else if constexpr (std::is_same_v<T, binary_echo>) {
+            run_binary_echo();
+          } else if constexpr (std::is_same_v<T, ballast>) {
+            run_ballast(arg.mib);
+          } else if constexpr (std::is_same_v<T, grandchildren>) {
+            run_grandchildren(arg);
+          } else if constexpr (std::is_same_v<T, discard_stdin>) {
+            run_discard_stdin();
+          } else if constexpr (std::is_same_v<T, ring_flood>) {
+            run_ring_flood(arg.count);
+          } else if constexpr (std::is_same_v<T, ring_sink>) {
+            run_ring_sink();
+          } else if constexpr (std::is_same_v<T, ping_pong>) {
+            for (int i{0}; i < arg.count; ++i) {
+              if (!sync(false)) {
+                throw std::runtime_error{"Timeout while waiting for sync"};
+              }
+            }
           } else {
             static_assert(!std::is_same_v<T, T>, "non-exhaustive visitor!");
           }
@@ -0,0 +1,245 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// replays a run log (see `exec_path_args/run_log.hxx`) - each recorded run is
+// re-issued at its (relative) arrival time through a `process_group`, as a
+// `some_cli_app` stand-in writing the same amount of stdout & stderr & then
+// sleeping for the rest of its recorded duration; `--speed N` compresses both
+// the arrivals & the durations N times
+// prints throughput & latencies (as CSV, the same as the benchmarks do)
+
+#include <time.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "exec_path_args/latency_histogram.hxx"
+#include "exec_path_args/process_group.hxx"
+#include "exec_path_args/run_log.hxx"
+
+namespace {
+
+using exec_path_args::os_wrapper::latency_histogram;
+using exec_path_args::os_wrapper::process_group;
+using exec_path_args::os_wrapper::run_log_reader;
+using exec_path_args::os_wrapper::run_record;
+
+[[nodiscard]] long long now_ns() noexcept {
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return static_cast<long long>(t.tv_sec) * 1'000'000'000 + t.tv_nsec;
+}
+
+struct replay_options {
+  std::string log_path;
+  std::string stand_in; // path of `some_cli_app`
+  double speed{1.0};
+  std::size_t limit{std::numeric_limits<std::size_t>::max()};
+};
+
+[[nodiscard]] replay_options parse(int const argc, char const **argv) {
+  static char const usage[]{
+      "Usage: run_log_replay <run log> <some_cli_app path> [--speed N] "
+      "[--limit first-N-runs]"};
+  if (argc < 3) {
+    throw std::runtime_error{usage};
+  }
+  replay_options options{argv[1], argv[2]};
+  for (int i{3}; i < argc; ++i) {
+    std::string_view const arg{argv[i]};
+    if ((arg == "--speed") && (i + 1 < argc)) {
+      options.speed = std::stod(argv[++i]);
+    } else if ((arg == "--limit") && (i + 1 < argc)) {
+      options.limit = std::stoull(argv[++i]);
+    } else {
+      throw std::runtime_error{usage};
+    }
+  }
+  if (!(options.speed > 0)) {
+    throw std::runtime_error{"--speed must be positive"};
+  }
+  return options;
+}
+
+[[nodiscard]] long long scaled_duration_ns(run_record const &r,
+                                           double const speed) {
+  return static_cast<long long>(
+      static_cast<double>(std::max<long long>(r.end_ns - r.start_ns, 0)) /
+      speed);
+}
+
+[[nodiscard]] std::vector<std::string> stand_in_args(run_record const &r,
+                                                     double const speed) {
+  std::vector<std::string> args;
+  if (r.stdout_bytes > 0) {
+    args.insert(args.end(),
+                {"--flood-stdout", std::to_string(r.stdout_bytes)});
+  }
+  if (r.stderr_bytes > 0) {
+    args.insert(args.end(),
+                {"--flood-stderr", std::to_string(r.stderr_bytes)});
+  }
+  // (whatever of the duration the output didn't take already)
+  args.insert(args.end(),
+              {"--sleep-until", std::to_string(scaled_duration_ns(r, speed) /
+                                               1'000'000)});
+  return args;
+}
+
+void report(std::string_view const metric, double const value,
+            std::string_view const unit) {
+  std::cout << "replay," << metric << ',' << value << ',' << unit << '\n';
+}
+
+void report_quantiles(std::string_view const metric,
+                      latency_histogram const &h) {
+  for (auto const &[suffix, q] :
+       {std::pair{"_p50", 0.5}, {"_p99", 0.99}, {"_max", 1.0}}) {
+    report(std::string{metric} + suffix,
+           static_cast<double>(h.quantile(q)) / 1'000'000, "ms");
+  }
+}
+
+} // namespace
+
+int main(int const argc, char const **argv) try {
+  auto const options{parse(argc, argv)};
+
+  run_log_reader const log{options.log_path};
+  std::vector<std::size_t> order(std::min(log.size(), options.limit));
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t const a, std::size_t const b) {
+                     return log[a].start_ns < log[b].start_ns;
+                   });
+  if (order.empty()) {
+    throw std::runtime_error{"nothing to replay - the run log is empty"};
+  }
+
+  process_group group;
+  group.reserve(order.size());
+
+  // how late each run started (vs. its scaled arrival), & how much longer it
+  // took than recorded (stand-in overhead, plus anything the library adds)
+  auto const start_lag{std::make_unique<latency_histogram>()};
+  auto const overrun{std::make_unique<latency_histogram>()};
+  std::vector<long long> expected_ns(order.size());
+  std::vector<process_group::index_t> running;
+  std::size_t failed{0};
+  unsigned long long output_bytes{0};
+
+  auto const first_start_ns{log[order.front()].start_ns};
+  auto const replay_start_ns{now_ns()};
+  auto const due_ns = [&](std::size_t const k) {
+    return replay_start_ns +
+           static_cast<long long>(
+               static_cast<double>(log[order[k]].start_ns - first_start_ns) /
+               options.speed);
+  };
+
+  std::size_t next{0};
+  while ((next < order.size()) || (group.running() > 0)) {
+    // issue whatever is due
+    auto const first_new{next};
+    while ((next < order.size()) && (due_ns(next) <= now_ns())) {
+      auto const &r{log[order[next]]};
+      expected_ns[group.add(std::string{options.stand_in},
+                            stand_in_args(r, options.speed))] =
+          scaled_duration_ns(r, options.speed);
+      ++next;
+    }
+    if (first_new < next) {
+      auto const failures{group.spawn_all()};
+      // done with those - not to be retried (& counted again) by the next
+      // `spawn_all`
+      for (auto const &failure : failures) {
+        group.cancel(failure.index);
+      }
+      failed += failures.size();
+      auto const spawned_ns{now_ns()};
+      for (auto k{first_new}; k < next; ++k) {
+        auto const i{static_cast<process_group::index_t>(k)};
+        if (group.get_state(i) == process_group::state::running) {
+          start_lag->record(spawned_ns - due_ns(k));
+          running.push_back(i);
+        }
+      }
+    }
+
+    int timeout_ms{-1};
+    if (next < order.size()) {
+      timeout_ms = static_cast<int>(std::max<long long>(
+          (due_ns(next) - now_ns() + 999'999) / 1'000'000, 0));
+    } else if (group.running() == 0) {
+      break;
+    }
+    if (group.update_all(timeout_ms) == 0) {
+      continue;
+    }
+
+    // collect whatever finished (& drop its output)
+    static_cast<void>(group.collect_outputs());
+    for (std::size_t j{0}; j < running.size();) {
+      auto const i{running[j]};
+      if (group.get_state(i) != process_group::state::finished) {
+        ++j;
+        continue;
+      }
+      output_bytes += group.get_stdout(i).size() + group.get_stderr(i).size();
+      overrun->record(std::max<long long>(
+          static_cast<long long>(group.time_running_ms(i) * 1'000'000) -
+              expected_ns[i],
+          0));
+      running[j] = running.back();
+      running.pop_back();
+    }
+  }
+  group.finish_all();
+
+  auto const elapsed_s{static_cast<double>(now_ns() - replay_start_ns) / 1e9};
+  auto const recorded_s{
+      static_cast<double>(log[order.back()].start_ns - first_start_ns) / 1e9 /
+      options.speed};
+
+  std::cout << "benchmark,metric,value,unit\n";
+  report("runs", static_cast<double>(order.size()), "runs");
+  report("failed", static_cast<double>(failed), "runs");
+  report("elapsed", elapsed_s, "s");
+  report("arrivals_span", recorded_s, "s");
+  report("throughput", static_cast<double>(order.size()) / elapsed_s,
+         "runs/s");
+  report("output", static_cast<double>(output_bytes) / elapsed_s / (1 << 20),
+         "MiB/s");
+  report_quantiles("start_lag", *start_lag);
+  report_quantiles("overrun", *overrun);
+  return EXIT_SUCCESS;
+} catch (std::exception const &e) {
+  std::cerr << "run_log_replay caught `std::exception`: " << e.what() << '\n';
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,102 @@
+/*
+  Copyright 2026 Lukáš Růžička
+
+  This file is part of exec_path_args.
+
+  exec_path_args is free software: you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your option)
+  any later version.
+
+  exec_path_args is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with exec_path_args. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// converts a run log (see `exec_path_args/run_log.hxx`) to CSV, on stdout
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "exec_path_args/exec_path_args.hxx"
+#include "exec_path_args/run_log.hxx"
+
+namespace {
+
+using exec_path_args::os_wrapper::exec_path_args;
+
+[[nodiscard]] char const *name_of(std::uint8_t const reason) {
+  switch (static_cast<exec_path_args::exit_reason>(reason)) {
+  case exec_path_args::exit_reason::exited:
+    return "exited";
+  case exec_path_args::exit_reason::signaled:
+    return "signaled";
+  case exec_path_args::exit_reason::killed:
+    return "killed";
+  case exec_path_args::exit_reason::cpu_limit_exceeded:
+    return "cpu_limit_exceeded";
+  case exec_path_args::exit_reason::file_size_limit_exceeded:
+    return "file_size_limit_exceeded";
+  case exec_path_args::exit_reason::timed_out:
+    return "timed_out";
+  case exec_path_args::exit_reason::inactive:
+    return "inactive";
+  }
+  return "unknown";
+}
+
+// https://www.rfc-editor.org/rfc/rfc4180 - always quoted, the parts of the
+// command separated by spaces
+void print_command(std::ostream &os, std::string_view const command) {
+  os << '"';
+  for (std::size_t i{0}; i < command.size(); ++i) {
+    char const c{command[i]};
+    if (c == '\0') {
+      if (i + 1 < command.size()) {
+        os << ' ';
+      }
+    } else if (c == '"') {
+      os << "\"\"";
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+} // namespace
+
+int main(int const argc, char const **argv) try {
+  if (argc != 2) {
+    throw std::runtime_error{"Usage: run_log_to_csv <run log path>"};
+  }
+
+  exec_path_args::os_wrapper::run_log_reader const log{argv[1]};
+
+  std::ios::sync_with_stdio(false);
+  std::cout << "command,exit_reason,return_code,start_ns,end_ns,wall_ns,"
+               "user_cpu_ns,system_cpu_ns,max_rss_kib,stdout_bytes,"
+               "stderr_bytes\n";
+  for (auto const &r : log) {
+    print_command(std::cout, log.command_of(r));
+    std::cout << ',' << name_of(r.exit_reason) << ',' << r.return_code << ','
+              << r.start_ns << ',' << r.end_ns << ',' << (r.end_ns - r.start_ns)
+              << ',' << r.user_cpu_ns << ',' << r.system_cpu_ns << ','
+              << r.max_rss_kib << ',' << r.stdout_bytes << ','
+              << r.stderr_bytes << '\n';
+  }
+  return EXIT_SUCCESS;
+} catch (std::exception const &e) {
+  std::cerr << "run_log_to_csv caught `std::exception`: " << e.what() << '\n';
+  return EXIT_FAILURE;
+}